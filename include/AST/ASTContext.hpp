@@ -6,15 +6,80 @@
 #include "Basic/SourceManager.hpp"
 #include "Types.hpp"
 
+#include <array>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
 namespace glu::ast {
 
 class ASTContext {
     TypedMemoryArena<ASTNode> _astMemoryArena;
     InternedMemoryArena<types::TypeBase> _typesMemoryArena;
     SourceManager *_sm;
+    /// @brief Scratch types arenas whose types are still used by the AST.
+    std::vector<std::unique_ptr<InternedMemoryArena<types::TypeBase>>>
+        _retainedTypesArenas;
+    std::mutex _retainedTypesArenasMutex;
+
+    /// @brief The canonical instances of the primitive types, interned when
+    /// the context is created.
+    types::BoolTy *_boolType;
+    types::CharTy *_charType;
+    types::VoidTy *_voidType;
+    types::NullTy *_nullType;
+    /// @brief The 8 to 128-bit integer types, by signedness then by width.
+    std::array<std::array<types::IntTy *, 5>, 2> _intTypes;
+    /// @brief The half, float, double and Intel long double types.
+    std::array<types::FloatTy *, 4> _floatTypes;
+
+    static std::optional<size_t> getIntTypeIndex(unsigned bitWidth)
+    {
+        switch (bitWidth) {
+        case 8: return 0;
+        case 16: return 1;
+        case 32: return 2;
+        case 64: return 3;
+        case 128: return 4;
+        default: return std::nullopt;
+        }
+    }
+
+    static std::optional<size_t> getFloatTypeIndex(unsigned bitWidth)
+    {
+        switch (bitWidth) {
+        case types::FloatTy::HALF: return 0;
+        case types::FloatTy::FLOAT: return 1;
+        case types::FloatTy::DOUBLE: return 2;
+        case types::FloatTy::INTEL_LONG_DOUBLE: return 3;
+        default: return std::nullopt;
+        }
+    }
 
 public:
-    ASTContext(SourceManager *sm = nullptr) : _sm(sm) { }
+    ASTContext(SourceManager *sm = nullptr) : _sm(sm)
+    {
+        _boolType = _typesMemoryArena.create<types::BoolTy>();
+        _charType = _typesMemoryArena.create<types::CharTy>();
+        _voidType = _typesMemoryArena.create<types::VoidTy>();
+        _nullType = _typesMemoryArena.create<types::NullTy>();
+        for (auto signedness :
+             { types::IntTy::Unsigned, types::IntTy::Signed }) {
+            for (unsigned bitWidth = 8; bitWidth <= 128; bitWidth *= 2) {
+                _intTypes[signedness][*getIntTypeIndex(bitWidth)]
+                    = _typesMemoryArena.create<types::IntTy>(
+                        signedness, bitWidth
+                    );
+            }
+        }
+        for (unsigned bitWidth :
+             { types::FloatTy::HALF, types::FloatTy::FLOAT,
+               types::FloatTy::DOUBLE, types::FloatTy::INTEL_LONG_DOUBLE }) {
+            _floatTypes[*getFloatTypeIndex(bitWidth)]
+                = _typesMemoryArena.create<types::FloatTy>(bitWidth);
+        }
+    }
 
     /// @brief Get the memory arena used by the AST context.
     /// @return The memory arena used by the AST context.
@@ -27,6 +92,50 @@ public:
         return _typesMemoryArena;
     }
 
+    /// @brief Get the canonical Bool type, without going through the types
+    /// arena. The same goes for the other primitive types.
+    types::BoolTy *getBoolType() const { return _boolType; }
+    types::CharTy *getCharType() const { return _charType; }
+    types::VoidTy *getVoidType() const { return _voidType; }
+    types::NullTy *getNullType() const { return _nullType; }
+
+    /// @brief Get the canonical integer type of the given signedness and
+    /// width. Only unusual widths go through the types arena.
+    types::IntTy *
+    getIntType(types::IntTy::Signedness signedness, unsigned bitWidth)
+    {
+        if (auto index = getIntTypeIndex(bitWidth))
+            return _intTypes[signedness][*index];
+        return _typesMemoryArena.create<types::IntTy>(signedness, bitWidth);
+    }
+
+    /// @brief Get the canonical floating-point type of the given width. Only
+    /// unusual widths go through the types arena.
+    types::FloatTy *getFloatType(unsigned bitWidth)
+    {
+        if (auto index = getFloatTypeIndex(bitWidth))
+            return _floatTypes[*index];
+        return _typesMemoryArena.create<types::FloatTy>(bitWidth);
+    }
+
+    /// @brief Keeps a scratch types arena alive as long as the context, when
+    /// the AST still references some of its types (e.g. after a type error).
+    /// @param arena The arena to keep alive.
+    void retainTypesArena(
+        std::unique_ptr<InternedMemoryArena<types::TypeBase>> arena
+    )
+    {
+        std::lock_guard<std::mutex> lock(_retainedTypesArenasMutex);
+        _retainedTypesArenas.push_back(std::move(arena));
+    }
+
+    /// @brief Returns the number of scratch types arenas kept alive.
+    size_t getRetainedTypesArenaCount()
+    {
+        std::lock_guard<std::mutex> lock(_retainedTypesArenasMutex);
+        return _retainedTypesArenas.size();
+    }
+
     /// @brief Get the source manager used by the AST context.
     /// @return The source manager used by the AST context.
     SourceManager *getSourceManager() const { return _sm; }
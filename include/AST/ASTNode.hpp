@@ -5,6 +5,7 @@
 #include "Types/TypeBase.hpp"
 #include "Visibility.hpp"
 
+#include <atomic>
 #include <cassert>
 #include <llvm/Support/raw_ostream.h>
 
@@ -66,6 +67,9 @@ public:
     SourceLocation getLocation() const { return _nodeLocation; }
 
     /// @brief Get the module in which the current node is declared.
+    ///
+    /// Functions and structs cache their module, so that lookups from them
+    /// or from the nodes they contain stop there.
     /// @return The module in which the current node is declared.
     ModuleDecl *getModule();
 
@@ -82,6 +86,11 @@ public:
     /// @brief Print a human-readable representation of this node to
     /// standard output, for debugging purposes.
     void print();
+
+private:
+    /// @brief Returns where a node caches its module, or nullptr if it does
+    /// not cache it.
+    static std::atomic<ModuleDecl *> *getModuleCache(ASTNode *node);
 };
 
 /// @brief Replace a child node in its parent node
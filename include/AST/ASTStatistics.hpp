@@ -0,0 +1,70 @@
+#ifndef GLU_AST_ASTSTATISTICS_HPP
+#define GLU_AST_ASTSTATISTICS_HPP
+
+#include "ASTNode.hpp"
+#include "Types/TypeBase.hpp"
+
+#include <llvm/Support/raw_ostream.h>
+
+#include <array>
+
+namespace glu::ast {
+
+class ASTContext;
+
+/// @brief The number of AST nodes or types of one kind, and their size.
+struct KindStatistics {
+    size_t count = 0;
+    /// @brief The bytes allocated for the objects, trailing storage included.
+    size_t bytes = 0;
+};
+
+/// @brief Counts the AST nodes of a module and the types of its context by
+/// kind, for -print-ast-stats.
+class ASTStatistics {
+public:
+    static constexpr size_t nodeKindCount = 0
+#define NODE_KIND(Name, Parent) +1
+#define NODE_KIND_SUPER(Name, Parent) +1
+#define NODE_KIND_SUPER_END(Name) +1
+#include "NodeKind.def"
+        ;
+    static constexpr size_t typeKindCount = 0
+#define TYPE(NAME) +1
+#include "Types/TypeKind.def"
+        ;
+
+private:
+    std::array<KindStatistics, nodeKindCount> _nodes {};
+    std::array<KindStatistics, typeKindCount> _types {};
+    size_t _astArenaBytes = 0;
+    size_t _typesArenaBytes = 0;
+
+public:
+    /// @brief Counts the nodes of a module, the module included.
+    void addModule(ModuleDecl *module);
+
+    /// @brief Counts the types of a context, and the memory allocated for
+    /// its nodes and types.
+    void addContext(ASTContext &context);
+
+    /// @brief Returns the statistics of the nodes of a kind.
+    KindStatistics const &getNodeStatistics(NodeKind kind) const
+    {
+        return _nodes[static_cast<size_t>(kind)];
+    }
+
+    /// @brief Returns the statistics of the types of a kind.
+    KindStatistics const &getTypeStatistics(types::TypeKind kind) const
+    {
+        return _types[static_cast<size_t>(kind)];
+    }
+
+    /// @brief Prints the totals, then the kinds using the most memory first.
+    /// @param os The output stream to print to.
+    void print(llvm::raw_ostream &os) const;
+};
+
+} // namespace glu::ast
+
+#endif // GLU_AST_ASTSTATISTICS_HPP
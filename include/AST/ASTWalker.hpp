@@ -8,6 +8,9 @@
 #include "Stmts.hpp"
 
 #include <llvm/ADT/ScopeExit.h>
+#include <llvm/ADT/SmallVector.h>
+
+#include <type_traits>
 
 namespace glu::ast {
 
@@ -36,16 +39,17 @@ public:
     )
     {
     }
-#define NODE_CHILD(Type, Name)                                             \
-    (node->get##Name()                                                     \
-         ? (this->visit(node->get##Name(), std::forward<ArgTys>(args)...)) \
-         : (void) 0)
+#define NODE_CHILD(Type, Name)                                                \
+    (node->get##Name() ? (this->asImpl()->visit(                              \
+                             node->get##Name(), std::forward<ArgTys>(args)... \
+                         ))                                                   \
+                       : (void) 0)
 #define NODE_TYPEREF(Type, Name) (void) 0
-#define NODE_CHILDREN(Type, Name)                          \
-    (void) 0;                                              \
-    for (auto child : node->get##Name()) {                 \
-        this->visit(child, std::forward<ArgTys>(args)...); \
-    }                                                      \
+#define NODE_CHILDREN(Type, Name)                                    \
+    (void) 0;                                                        \
+    for (auto child : node->get##Name()) {                           \
+        this->asImpl()->visit(child, std::forward<ArgTys>(args)...); \
+    }                                                                \
     (void) 0
 #define NODE_KIND_SUPER(Name, Parent)                                          \
     void preVisit##Name(Name *node, ArgTys... args)                            \
@@ -72,6 +76,121 @@ public:
 #include "NodeKind.def"
 };
 
+/// @brief An ASTWalker that keeps the nodes being visited on an explicit
+/// stack instead of the native one, so that deep trees (e.g. long chains of
+/// binary operators in generated code) cannot overflow it.
+/// @tparam Impl the implementation class that inherits from this class.
+/// @details
+/// The methods are called in the same order as with ASTWalker. A node whose
+/// _visit<NodeKind> method is overridden is visited by that method, which may
+/// visit its children recursively; they are walked iteratively again.
+template <typename Impl>
+class IterativeASTWalker : public ASTWalker<Impl, void> {
+    using Base = ASTWalker<Impl, void>;
+
+    /// @brief A node whose children are being visited.
+    struct Frame {
+        ASTNode *node;
+        /// @brief The next child or list of children to visit.
+        unsigned entry = 0;
+        /// @brief The next child to visit in the current list.
+        unsigned index = 0;
+    };
+
+    /// @brief Returns the next child of a node and advances past it, or
+    /// returns null if all children were visited. Children are read as late
+    /// as with ASTWalker, so that they can be replaced by previous visits.
+    static ASTNode *nextChild(Frame &frame)
+    {
+        switch (frame.node->getKind()) {
+#define NODE_CHILD(Type, Name)                               \
+    (!child && entry++ == frame.entry                        \
+         ? (void) (child = node->get##Name(), ++frame.entry) \
+         : (void) 0)
+#define NODE_CHILDREN(Type, Name)                                   \
+    (!child && entry++ == frame.entry                               \
+         ? (frame.index < node->get##Name().size()                  \
+                ? (void) (child = node->get##Name()[frame.index++]) \
+                : (void) (frame.index = 0, ++frame.entry))          \
+         : (void) 0)
+#define NODE_TYPEREF(Type, Name) (void) 0
+#define NODE_KIND_(Name, Parent, ...)                           \
+case NodeKind::Name##Kind: {                                    \
+    [[maybe_unused]] auto *node = llvm::cast<Name>(frame.node); \
+    [[maybe_unused]] unsigned entry = 0;                        \
+    ASTNode *child = nullptr;                                   \
+    __VA_ARGS__;                                                \
+    return child;                                               \
+}
+#define NODE_KIND(Name, Parent)
+#include "NodeKind.def"
+        default: llvm_unreachable("Unknown node kind.");
+        }
+    }
+
+    /// @brief Starts visiting a node.
+    /// @return True if its children remain to be visited, false if an
+    /// overridden _visit<NodeKind> method visited the node entirely.
+    bool enter(ASTNode *node)
+    {
+        Impl *impl = this->asImpl();
+        impl->beforeVisitNode(node);
+        switch (node->getKind()) {
+#define NODE_KIND_(Name, Parent, ...)                 \
+case NodeKind::Name##Kind:                            \
+    if constexpr (std::is_same_v<                     \
+                      decltype(&Impl::_visit##Name),  \
+                      void (Base::*)(Name *)>) {      \
+        impl->preVisit##Name(llvm::cast<Name>(node)); \
+        return true;                                  \
+    } else {                                          \
+        impl->_visit##Name(llvm::cast<Name>(node));   \
+        impl->afterVisitNode(node);                   \
+        return false;                                 \
+    }
+#define NODE_KIND(Name, Parent)
+#include "NodeKind.def"
+        default: llvm_unreachable("Unknown node kind.");
+        }
+    }
+
+    /// @brief Finishes visiting a node once its children were visited.
+    void leave(ASTNode *node)
+    {
+        Impl *impl = this->asImpl();
+        switch (node->getKind()) {
+#define NODE_KIND_(Name, Parent, ...)              \
+case NodeKind::Name##Kind:                         \
+    impl->postVisit##Name(llvm::cast<Name>(node)); \
+    break;
+#define NODE_KIND(Name, Parent)
+#include "NodeKind.def"
+        default: llvm_unreachable("Unknown node kind.");
+        }
+        impl->afterVisitNode(node);
+    }
+
+public:
+    /// @brief Visits a node and all of its descendants.
+    /// @param node The node to visit.
+    void visit(ASTNode *node)
+    {
+        if (!enter(node))
+            return;
+
+        llvm::SmallVector<Frame, 32> stack;
+        stack.push_back({ node });
+        while (!stack.empty()) {
+            if (ASTNode *child = nextChild(stack.back())) {
+                if (enter(child))
+                    stack.push_back({ child });
+                continue;
+            }
+            leave(stack.pop_back_val().node);
+        }
+    }
+};
+
 } // namespace glu::ast
 
 #endif // GLU_AST_WALKER_HPP
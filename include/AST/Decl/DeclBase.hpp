@@ -12,10 +12,11 @@ namespace glu::ast {
 
 class DeclBase : public ASTNode {
 private:
-    /// @brief The visibility of this declaration.
-    Visibility _visibility;
     /// @brief The attributes attached to this declaration.
     GLU_AST_GEN_CHILD(DeclBase, AttributeList *, _attributes, Attributes)
+    /// @brief The visibility of this declaration. Declared last, so that
+    /// subclasses can place a 4-byte member in the padding after it.
+    Visibility _visibility;
 
 protected:
     DeclBase(
@@ -24,8 +25,8 @@ protected:
         AttributeList *attributes = nullptr
     )
         : ASTNode(kind, nodeLocation, parent)
-        , _visibility(visibility)
         , _attributes(attributes)
+        , _visibility(visibility)
     {
         assert(
             kind > NodeKind::DeclBaseFirstKind
@@ -29,10 +29,17 @@ enum class BuiltinKind {
 class FunctionDecl final
     : public DeclBase,
       private llvm::TrailingObjects<FunctionDecl, ParamDecl *> {
+    friend class ASTNode;
+
 private:
+    /// Declared first to fill the padding at the end of DeclBase.
+    BuiltinKind _builtinKind = BuiltinKind::None;
     llvm::StringRef _name;
     glu::types::FunctionTy *_type;
-    BuiltinKind _builtinKind = BuiltinKind::None;
+    /// The module containing the function, once looked up. GILGen and the
+    /// nodes of the body ask for it often. Atomic since function bodies are
+    /// checked concurrently.
+    std::atomic<ModuleDecl *> _module = nullptr;
 
     GLU_AST_GEN_CHILD(
         FunctionDecl, TemplateParameterList *, _templateParams, TemplateParams
@@ -69,9 +76,9 @@ private:
         : DeclBase(
               NodeKind::FunctionDeclKind, location, nullptr, visibility, nullptr
           )
+        , _builtinKind(builtinKind)
         , _name(std::move(name))
         , _type(type)
-        , _builtinKind(builtinKind)
     {
         initTemplateParams(nullptr, /* nullable = */ true);
         initBody(nullptr, /* nullable = */ true);
@@ -9,8 +9,12 @@
 #include "TypeDecl.hpp"
 #include "Types.hpp"
 
+#include <llvm/ADT/STLExtras.h>
 #include <llvm/ADT/SmallVector.h>
 
+#include <algorithm>
+#include <numeric>
+
 namespace glu::ast {
 
 /// @class StructDecl
@@ -22,15 +26,24 @@ namespace glu::ast {
 class StructDecl final
     : public TypeDecl,
       private llvm::TrailingObjects<StructDecl, FieldDecl *> {
-    GLU_AST_GEN_CHILD(
-        StructDecl, TemplateParameterList *, _templateParams, TemplateParams
-    )
+    friend class ASTNode;
+
+    // The field count comes first to fill the padding at the end of DeclBase.
     GLU_AST_GEN_CHILDREN_TRAILING_OBJECTS(
         StructDecl, _numFields, FieldDecl *, Fields
     )
+    GLU_AST_GEN_CHILD(
+        StructDecl, TemplateParameterList *, _templateParams, TemplateParams
+    )
 private:
     llvm::StringRef _name;
     glu::types::StructTy *_self;
+    /// @brief The indices of the fields, sorted by field name, to look up
+    /// fields by name.
+    unsigned *_fieldsByName;
+    /// The module containing the struct, once looked up. Instantiations ask
+    /// for it to substitute their field types.
+    std::atomic<ModuleDecl *> _module = nullptr;
 
     // Ownership
 
@@ -67,6 +80,18 @@ public:
     {
         initTemplateParams(templateParams, /* nullable = */ true);
         initFields(fields);
+
+        _fieldsByName = context.getASTMemoryArena()
+                            .getAllocator()
+                            .Allocate<unsigned>(_numFields);
+        std::iota(_fieldsByName, _fieldsByName + _numFields, 0);
+        // Stable, so that the first of duplicate fields is found
+        std::stable_sort(
+            _fieldsByName, _fieldsByName + _numFields,
+            [this](unsigned lhs, unsigned rhs) {
+                return getField(lhs)->getName() < getField(rhs)->getName();
+            }
+        );
     }
 
     static StructDecl *create(
@@ -127,10 +152,12 @@ public:
     /// @return Returns the index of the field if found, or std::nullopt if not.
     std::optional<size_t> getFieldIndex(llvm::StringRef name) const
     {
-        for (size_t i = 0; i < _numFields; ++i) {
-            if (getField(i)->getName() == name)
-                return i;
-        }
+        llvm::ArrayRef<unsigned> fieldsByName(_fieldsByName, _numFields);
+        auto it = llvm::partition_point(fieldsByName, [&](unsigned index) {
+            return getField(index)->getName() < name;
+        });
+        if (it != fieldsByName.end() && getField(*it)->getName() == name)
+            return *it;
         return std::nullopt;
     }
 
@@ -102,6 +102,12 @@ public:
     /// @return Returns the number of parameters
     std::size_t getParameterCount() const { return _numParams; }
 
+    /// @brief Returns the size of this type, parameters included.
+    std::size_t getAllocatedSize() const
+    {
+        return totalSizeToAlloc<TypeBase *>(_numParams);
+    }
+
     /// @brief Getter for the number of required parameters.
     /// @return Returns the number of required parameters (those without
     /// default values).
@@ -8,6 +8,7 @@
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/TrailingObjects.h>
 
+#include <atomic>
 #include <memory>
 
 namespace glu::ast {
@@ -17,15 +18,39 @@ class FieldDecl;
 
 namespace glu::types {
 
+/// @brief The type of a field of a struct instantiation, with the template
+/// parameters substituted, cached by StructTy.
+struct SubstitutedFieldType {
+    /// @brief The declared type of the field the entry caches the
+    /// substitution of, or null if no thread claimed the entry yet. It is set
+    /// at most once.
+    std::atomic<TypeBase *> declaredType = nullptr;
+    /// @brief The substitution of declaredType, or null until the thread
+    /// that claimed the entry stored it.
+    std::atomic<TypeBase *> substitutedType = nullptr;
+};
+
 /// @brief StructTy is a class that represents structures declared in code.
-class StructTy final : public TypeBase,
-                       private llvm::TrailingObjects<StructTy, TypeBase *> {
-    using TrailingArgs = llvm::TrailingObjects<StructTy, TypeBase *>;
+class StructTy final
+    : public TypeBase,
+      private llvm::TrailingObjects<
+          StructTy, TypeBase *, SubstitutedFieldType> {
+    using TrailingArgs
+        = llvm::TrailingObjects<StructTy, TypeBase *, SubstitutedFieldType>;
     friend TrailingArgs;
 
 private:
     glu::ast::StructDecl *_decl;
     unsigned _numTemplateArgs;
+    /// @brief The number of cached substituted field types: the number of
+    /// fields for instantiations of templates, 0 otherwise.
+    unsigned _numSubstitutedFields;
+
+    /// @brief Returns the number of field types an instantiation caches.
+    static unsigned getSubstitutedFieldCount(
+        glu::ast::StructDecl *decl,
+        llvm::ArrayRef<glu::types::TypeBase *> templateArgs
+    );
 
 public:
     StructTy(
@@ -35,11 +60,15 @@ public:
         : TypeBase(TypeKind::StructTyKind)
         , _decl(decl)
         , _numTemplateArgs(templateArgs.size())
+        , _numSubstitutedFields(getSubstitutedFieldCount(decl, templateArgs))
     {
         std::uninitialized_copy(
             templateArgs.begin(), templateArgs.end(),
             getTrailingObjects<TypeBase *>()
         );
+        std::uninitialized_default_construct_n(
+            getTrailingObjects<SubstitutedFieldType>(), _numSubstitutedFields
+        );
     }
 
     static StructTy *create(
@@ -48,7 +77,11 @@ public:
     )
     {
         void *mem = allocator.Allocate(
-            totalSizeToAlloc<TypeBase *>(templateArgs.size()), alignof(StructTy)
+            totalSizeToAlloc<TypeBase *, SubstitutedFieldType>(
+                templateArgs.size(),
+                getSubstitutedFieldCount(decl, templateArgs)
+            ),
+            alignof(StructTy)
         );
         return new (mem) StructTy(decl, templateArgs);
     }
@@ -75,6 +108,8 @@ public:
     uint64_t getAlignment() const;
 
     /// @brief Returns the field type with template parameters substituted.
+    /// The result is computed once per instantiation, then cached until the
+    /// declared type of the field changes.
     /// @param index The index of the field.
     /// @return The field type with template parameters replaced by concrete
     /// types.
@@ -85,6 +120,12 @@ public:
         return _numTemplateArgs;
     }
 
+    size_t
+    numTrailingObjects(TrailingArgs::OverloadToken<SubstitutedFieldType>) const
+    {
+        return _numSubstitutedFields;
+    }
+
     llvm::ArrayRef<TypeBase *> getTemplateArgs() const
     {
         return llvm::ArrayRef<TypeBase *>(
@@ -92,6 +133,15 @@ public:
         );
     }
 
+    /// @brief Returns the size of this type, template arguments and cached
+    /// field types included.
+    size_t getAllocatedSize() const
+    {
+        return totalSizeToAlloc<TypeBase *, SubstitutedFieldType>(
+            _numTemplateArgs, _numSubstitutedFields
+        );
+    }
+
     /// @brief Static method to check if a type is a StructTy.
     static bool classof(TypeBase const *type)
     {
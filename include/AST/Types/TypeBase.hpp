@@ -58,6 +58,10 @@ inline std::string operator+(glu::types::TypeKind kind, std::string const &rhs)
 ///        elements each types should at least have.
 class TypeBase {
     TypeKind const _kind;
+    /// @brief The structural hash, computed by the first call to hash(), or
+    /// 0 until then. Types are immutable, and the types arena hashes them
+    /// when interning, before other threads can see them.
+    mutable unsigned _hash = 0;
 
 public:
     /// @brief Getter for the kind of the Type.
@@ -75,7 +79,8 @@ public:
     /// @return Returns true if the two types are equal, false otherwise
     bool operator==(TypeBase const &other) const;
 
-    /// @brief Polymorphic hash function
+    /// @brief Polymorphic hash function. The hash is computed once, then
+    /// stored in the type.
     /// @return Returns the hash value of the type
     unsigned hash() const;
 
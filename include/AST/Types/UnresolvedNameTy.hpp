@@ -140,6 +140,15 @@ public:
         );
     }
 
+    /// @brief Returns the size of this type, name components and template
+    /// arguments included.
+    size_t getAllocatedSize() const
+    {
+        return totalSizeToAlloc<llvm::StringRef, glu::types::TypeBase *>(
+            _numComponents + 1, _numTemplateArgs
+        );
+    }
+
     /// @brief Getter for the name of the unresolved type.
     /// @return The name of the unresolved type.
     llvm::StringRef getName() const
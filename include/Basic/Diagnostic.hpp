@@ -72,7 +72,7 @@ public:
 class DiagnosticManager {
     SourceManager &_sourceManager;
     llvm::SmallVector<Diagnostic, 8> _messages;
-    bool _hasErrors = false;
+    size_t _errorCount = 0;
 
 public:
     /// @brief Constructs a DiagnosticManager instance.
@@ -108,7 +108,10 @@ public:
 
     /// @brief Returns whether any errors have been reported.
     /// @return True if any errors have been reported, false otherwise.
-    bool hasErrors() const { return _hasErrors; }
+    bool hasErrors() const { return _errorCount != 0; }
+
+    /// @brief Returns the number of errors reported so far.
+    size_t getErrorCount() const { return _errorCount; }
 
     /// @brief Returns all collected diagnostic messages.
     /// @return A vector of all diagnostic messages.
@@ -117,6 +120,15 @@ public:
         return _messages;
     }
 
+    /// @brief Returns the source manager used for location information.
+    SourceManager &getSourceManager() const { return _sourceManager; }
+
+    /// @brief Moves all diagnostics reported to another manager into this
+    /// one, after the diagnostics already reported here.
+    /// @param other The manager to take the diagnostics from. It is left
+    /// empty.
+    void takeDiagnostics(DiagnosticManager &other);
+
 private:
     /// @brief Adds a diagnostic message to the collection.
     /// @param severity The severity level of the diagnostic.
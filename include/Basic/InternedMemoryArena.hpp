@@ -3,10 +3,15 @@
 
 #include "TypedMemoryArena.hpp"
 
+#include <llvm/ADT/ArrayRef.h>
 #include <llvm/ADT/DenseMapInfo.h>
 #include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/ScopeExit.h>
 #include <llvm/Support/Casting.h>
 
+#include <cassert>
+#include <memory>
+#include <mutex>
 #include <type_traits>
 
 namespace glu {
@@ -43,36 +48,151 @@ template <typename Base> struct BaseDenseSetInternInfo {
     }
 };
 
+/// @brief A memory arena that creates a single instance of each distinct
+/// object, so that objects can be compared by address.
+///
+/// Objects are spread over several shards by hash, each with its own lock,
+/// set and allocator, so that threads creating different objects rarely wait
+/// for each other.
 template <typename Base>
 class InternedMemoryArena : public TypedMemoryArena<Base> {
-    llvm::DenseSet<Base *, BaseDenseSetInternInfo<Base>> _internedSet;
 
-    template <typename T, typename... Args> T *findInterned(Args &&...args)
+    /// @brief The objects whose hash selects this shard, and where they are
+    /// allocated. Aligned so that threads working on neighbouring shards do
+    /// not share cache lines.
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        llvm::DenseSet<Base *, BaseDenseSetInternInfo<Base>> internedSet;
+        llvm::BumpPtrAllocator allocator;
+    };
+    unsigned _shardBits;
+    std::unique_ptr<Shard[]> _shards;
+
+    /// @brief Where the current thread creates temporary objects instead of
+    /// this arena, see ScratchScope.
+    struct Scratch {
+        InternedMemoryArena *arena;
+        InternedMemoryArena *scratch;
+        bool (*isTemporary)(Base *);
+    };
+    static inline thread_local Scratch const *_activeScratch = nullptr;
+
+    /// @brief Where the calling thread builds the keys of its lookups.
+    static inline thread_local llvm::BumpPtrAllocator _keyAllocator;
+
+    /// @brief Returns the shard of an object from the top bits of its
+    /// scrambled hash, the sets already using the low bits for their buckets.
+    Shard &getShard(Base const *obj)
     {
+        if (_shardBits == 0)
+            return _shards[0];
+        unsigned scrambled = obj->hash() * 0x9E3779B9u;
+        return _shards[scrambled >> (32 - _shardBits)];
+    }
 
-        llvm::BumpPtrAllocator tmpAllocator;
-
-        T *tmp = this->template createWithAllocator<T>(
-            tmpAllocator, std::forward<Args>(args)...
-        );
-
-        auto it = _internedSet.find_as(tmp);
-        if (it != _internedSet.end())
-            return llvm::cast<T>(*it);
-        return nullptr;
+    /// @brief Returns all the shards of the arena.
+    llvm::MutableArrayRef<Shard> shards()
+    {
+        return { _shards.get(), size_t(1) << _shardBits };
     }
 
 public:
+    /// @brief Creates an arena of 2^shardBits shards. Arenas filled by a
+    /// single thread, such as scratch arenas, only need one.
+    explicit InternedMemoryArena(unsigned shardBits = 4)
+        : _shardBits(shardBits)
+        , _shards(std::make_unique<Shard[]>(size_t(1) << shardBits))
+    {
+        assert(shardBits < 32 && "Too many shards");
+    }
+
+    /// @brief Makes the current thread create the objects selected by a
+    /// predicate in a scratch arena instead, for the lifetime of this object.
+    ///
+    /// Objects are interned in the scratch arena and freed with it. Everything
+    /// else is still interned in the permanent arena, so that objects never
+    /// have two canonical addresses, and the predicate must select every
+    /// object referencing a temporary one.
+    class ScratchScope {
+        Scratch _scratch;
+        Scratch const *_previous;
+
+    public:
+        ScratchScope(
+            InternedMemoryArena &arena, InternedMemoryArena &scratch,
+            bool (*isTemporary)(Base *)
+        )
+            : _scratch { &arena, &scratch, isTemporary }
+            , _previous(_activeScratch)
+        {
+            _activeScratch = &_scratch;
+        }
+
+        ~ScratchScope() { _activeScratch = _previous; }
+
+        ScratchScope(ScratchScope const &) = delete;
+        ScratchScope &operator=(ScratchScope const &) = delete;
+    };
+
     template <typename T, typename... Args> T *create(Args &&...args)
     {
-        if (T *interned = findInterned<T>(std::forward<Args>(args)...))
-            return interned;
+        // The lookup key lives in an allocator owned by the calling thread,
+        // so only the lookup and insertion need a lock. It is reset once
+        // the key is no longer needed, keeping its first slab, so that
+        // lookups do not allocate. Creating an object never creates another
+        // one, so keys are never nested.
+        auto resetKeyAllocator
+            = llvm::make_scope_exit([] { _keyAllocator.Reset(); });
+        T *key = this->template createWithAllocator<T>(
+            _keyAllocator, std::forward<Args>(args)...
+        );
 
-        T *obj
-            = static_cast<TypedMemoryArena<Base> *>(this)->template create<T>(
-                std::forward<Args>(args)...
+        if (_activeScratch && _activeScratch->arena == this
+            && _activeScratch->isTemporary(key))
+            return _activeScratch->scratch->intern(
+                key, std::forward<Args>(args)...
             );
-        _internedSet.insert(obj);
+        return intern(key, std::forward<Args>(args)...);
+    }
+
+    /// @brief Calls a function on every object of the arena, in no particular
+    /// order. Objects must not be created from the function.
+    template <typename Fn> void forEach(Fn &&fn)
+    {
+        for (Shard &shard : shards()) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (Base *obj : shard.internedSet)
+                fn(obj);
+        }
+    }
+
+    /// @brief Returns the number of bytes allocated for the objects of the
+    /// arena, padding included.
+    size_t getBytesAllocated()
+    {
+        size_t bytes = 0;
+        for (Shard &shard : shards()) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            bytes += shard.allocator.getBytesAllocated();
+        }
+        return bytes;
+    }
+
+private:
+    /// @brief Returns the interned object equal to key, creating it from args
+    /// if there is none yet.
+    template <typename T, typename... Args> T *intern(T *key, Args &&...args)
+    {
+        Shard &shard = getShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.internedSet.find_as(key);
+        if (it != shard.internedSet.end())
+            return llvm::cast<T>(*it);
+
+        T *obj = this->template createWithAllocator<T>(
+            shard.allocator, std::forward<Args>(args)...
+        );
+        shard.internedSet.insert(obj);
         return obj;
     }
 };
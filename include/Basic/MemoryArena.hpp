@@ -3,25 +3,83 @@
 
 #include <llvm/Support/Allocator.h>
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace glu {
 
 /// @brief A memory arena that can be used to allocate memory.
 class MemoryArena {
     llvm::BumpPtrAllocator allocator;
 
+    /// @brief Allocators of the threads holding a ThreadShard, kept alive as
+    /// long as the arena.
+    std::vector<std::unique_ptr<llvm::BumpPtrAllocator>> _shards;
+    std::mutex _shardsMutex;
+
+    /// @brief The arena the current thread has a shard of, and that shard.
+    static inline thread_local MemoryArena *_shardArena = nullptr;
+    static inline thread_local llvm::BumpPtrAllocator *_shardAllocator
+        = nullptr;
+
 public:
     MemoryArena() = default;
     ~MemoryArena() = default;
 
+    /// @brief Makes the current thread allocate from its own allocator for
+    /// the lifetime of this object, so that several threads can allocate
+    /// from the same arena. The memory is owned by the arena.
+    class ThreadShard {
+        MemoryArena *_previousArena;
+        llvm::BumpPtrAllocator *_previousAllocator;
+
+    public:
+        explicit ThreadShard(MemoryArena &arena)
+            : _previousArena(_shardArena), _previousAllocator(_shardAllocator)
+        {
+            std::lock_guard<std::mutex> lock(arena._shardsMutex);
+            arena._shards.push_back(std::make_unique<llvm::BumpPtrAllocator>());
+            _shardArena = &arena;
+            _shardAllocator = arena._shards.back().get();
+        }
+
+        ~ThreadShard()
+        {
+            _shardArena = _previousArena;
+            _shardAllocator = _previousAllocator;
+        }
+
+        ThreadShard(ThreadShard const &) = delete;
+        ThreadShard &operator=(ThreadShard const &) = delete;
+    };
+
     /// @brief Get the allocator used by the memory arena.
-    /// @return The allocator used by the memory arena.
-    llvm::BumpPtrAllocator &getAllocator() { return allocator; }
+    /// @return The allocator used by the memory arena, or the current
+    /// thread's shard if it holds one.
+    llvm::BumpPtrAllocator &getAllocator()
+    {
+        if (_shardArena == this)
+            return *_shardAllocator;
+        return allocator;
+    }
+
+    /// @brief Returns the number of bytes allocated from the arena and from
+    /// the shards of every thread, padding included.
+    size_t getBytesAllocated()
+    {
+        std::lock_guard<std::mutex> lock(_shardsMutex);
+        size_t bytes = allocator.getBytesAllocated();
+        for (auto &shard : _shards)
+            bytes += shard->getBytesAllocated();
+        return bytes;
+    }
 
     /// @brief Allocate memory in the memory arena.
     /// @return A pointer to the allocated memory.
     template <typename T, typename... Args> T *allocate(Args &&...args)
     {
-        void *mem = allocator.Allocate(sizeof(T), alignof(T));
+        void *mem = getAllocator().Allocate(sizeof(T), alignof(T));
         return new (mem) T(std::forward<Args>(args)...);
     }
 };
@@ -39,6 +39,8 @@ public:
 
     bool operator==(FileID const &other) const { return _id == other._id; }
     bool operator!=(FileID const &other) const { return _id != other._id; }
+    /// @brief Orders files by the order they were loaded in.
+    bool operator<(FileID const &other) const { return _id < other._id; }
 };
 
 ///
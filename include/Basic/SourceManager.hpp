@@ -5,7 +5,9 @@
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/VirtualFileSystem.h>
+#include <atomic>
 #include <string>
+#include <vector>
 
 #include "SourceLocation.hpp"
 #include "Tokens.hpp"
@@ -50,6 +52,10 @@ class FileLocEntry {
     /// The buffer containing the content of the file.
     std::unique_ptr<llvm::MemoryBuffer> _buffer;
 
+    /// The offset in the file of the start of each line, built the first time
+    /// a line or column is looked up in the file.
+    mutable std::vector<uint32_t> _lineStarts;
+
 public:
     FileLocEntry(
         uint32_t offset, std::unique_ptr<llvm::MemoryBuffer> buffer,
@@ -95,6 +101,15 @@ public:
     uint32_t getOffset() const { return _offset; }
 
     llvm::StringRef getFileName() const { return _fileName; }
+
+    /// Return the offset in the file of the start of each line, sorted. The
+    /// table is built on the first call, which must happen after the buffer
+    /// is loaded.
+    llvm::ArrayRef<uint32_t> getLineStarts() const;
+
+    /// Return the index, starting at 0, of the line containing an offset in
+    /// the file.
+    unsigned getLineIndex(uint32_t offsetInFile) const;
 };
 
 ///
@@ -126,6 +141,23 @@ class SourceManager {
     /// The FileID of the main file.
     FileID _mainFile;
 
+    /// The start offset of every non-empty loaded file, sorted. Files get
+    /// their offset when their content is loaded, so they are appended in
+    /// order.
+    llvm::SmallVector<std::pair<uint32_t, FileID>, 0> _filesByOffset;
+
+    /// The start of the buffer of every non-empty loaded file, sorted by
+    /// address.
+    llvm::SmallVector<std::pair<char const *, FileID>, 0> _filesByBuffer;
+
+    /// The file found by the last lookup by offset and by buffer pointer.
+    /// Consecutive lookups are usually in the same file.
+    mutable std::atomic<int> _lastOffsetLookup = -1;
+    mutable std::atomic<int> _lastBufferLookup = -1;
+
+    /// Add a file whose content was just loaded to the lookup indexes.
+    void indexLoadedFile(FileID fid);
+
 public:
     SourceManager()
         : _nextOffset(0), _vfs(llvm::vfs::getRealFileSystem()), _mainFile(0)
@@ -16,14 +16,17 @@ class Member {
     Type _type; ///< The type of the member.
     Type _parent; ///< The parent type that contains this member (must represent
                   ///< a StructTy or EnumTy).
+    unsigned _index; ///< The index of the field or variant in the parent.
 
 public:
     /// @brief Constructs a Member with the given name, type, and parent type.
     /// @param name The name of the member.
     /// @param type The type of the member.
     /// @param parent A pointer to the parent type that contains this member.
-    Member(llvm::StringRef name, Type type, Type parent)
-        : _name(name), _type(type), _parent(parent)
+    /// @param index The index of the member in the parent's fields, resolved
+    /// once when the member is created.
+    Member(llvm::StringRef name, Type type, Type parent, unsigned index)
+        : _name(name), _type(type), _parent(parent), _index(index)
     {
     }
 
@@ -39,6 +42,10 @@ public:
     /// @return A pointer to the parent type.
     Type getParent() const { return _parent; }
 
+    /// @brief Gets the index of this member in the parent's fields.
+    /// @return The index of the struct field or enum variant.
+    unsigned getIndex() const { return _index; }
+
     /// @brief Checks if two members are equal.
     /// @param other The other member to compare with.
     /// @return True if both members have the same name, parent, and type.
@@ -62,7 +69,8 @@ template <> struct DenseMapInfo<glu::gil::Member> {
     static inline glu::gil::Member getEmptyKey()
     {
         return glu::gil::Member(
-            llvm::DenseMapInfo<llvm::StringRef>::getEmptyKey(), nullptr, nullptr
+            llvm::DenseMapInfo<llvm::StringRef>::getEmptyKey(), nullptr,
+            nullptr, 0
         );
     }
 
@@ -70,7 +78,7 @@ template <> struct DenseMapInfo<glu::gil::Member> {
     {
         return glu::gil::Member(
             llvm::DenseMapInfo<llvm::StringRef>::getTombstoneKey(), nullptr,
-            nullptr
+            nullptr, 0
         );
     }
 
@@ -384,8 +384,10 @@ public:
     gil::EnumVariantInst *
     buildEnumVariant(gil::Type enumType, llvm::StringRef name)
     {
+        auto index = llvm::cast<types::EnumTy>(enumType)->getFieldIndex(name);
+        assert(index && "Enum variant not found");
         return insertInstruction(new gil::EnumVariantInst(
-            gil::Member(name, enumType, enumType)
+            gil::Member(name, enumType, enumType, *index)
         ));
     }
 
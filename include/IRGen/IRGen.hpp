@@ -3,6 +3,7 @@
 
 #include "GIL/Module.hpp"
 
+#include <llvm/ADT/SmallPtrSet.h>
 #include <llvm/IR/Module.h>
 
 namespace glu::irgen {
@@ -16,8 +17,12 @@ public:
     /// @param mod The input GIL module.
     /// @param sourceManager The source manager for debug information, or
     /// nullptr if for no debug info.
+    /// @param referencedModules If not null, receives the modules declaring
+    /// the functions, globals and runtime types referenced by the generated
+    /// code, including the module being generated itself.
     void generateIR(
-        llvm::Module &out, glu::gil::Module *mod, SourceManager *sourceManager
+        llvm::Module &out, glu::gil::Module *mod, SourceManager *sourceManager,
+        llvm::SmallPtrSetImpl<ast::ModuleDecl *> *referencedModules = nullptr
     );
 };
 
@@ -2,13 +2,20 @@
 #define GLU_SEMA_CONSTRAINT_SYSTEM_HPP
 
 #include "Basic/Diagnostic.hpp"
+#include "Basic/InternedMemoryArena.hpp"
 #include "Constraint.hpp"
+#include "OperatorTable.hpp"
+#include "OverloadCache.hpp"
 #include "ScopeTable.hpp"
+#include "SolverStatistics.hpp"
 
 #include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/DenseSet.h>
 #include <llvm/ADT/ilist.h>
 
+#include <atomic>
+#include <memory>
+
 namespace glu::sema {
 
 // Forward declarations
@@ -39,6 +46,23 @@ using Score = unsigned;
 /// It is used to explore multiple resolution paths during constraint solving
 /// (e.g., disjunctions, overloads, conversions).
 struct SystemState {
+    /// @brief A change made to a SystemState, recorded so that it can be
+    /// undone when the solver backtracks.
+    struct TrailEntry {
+        enum class Kind : uint8_t {
+            TypeBinding,
+            OverloadChoice,
+            ImplicitConversion,
+            CertainConversion,
+            Defaultable
+        };
+        Kind kind;
+        /// @brief The key of the changed map entry, if any.
+        void *key;
+        /// @brief The previous value of the entry, or nullptr if it was absent.
+        void *previous;
+    };
+
     /// @brief The AST context for creating new types.
     ast::ASTContext *_context;
     /// @brief Type variable bindings (type variable -> type).
@@ -57,9 +81,72 @@ struct SystemState {
 
     size_t defaultableConstraintsSatisfied = 0;
 
+    /// @brief Recorded conversions between two types that are already free of
+    /// type variables. Each of them costs exactly one conversion in any
+    /// solution reached from this state, so their count is a lower bound of
+    /// the final conversion count, maintained incrementally.
+    llvm::DenseSet<glu::ast::ExprBase *> certainConversions;
+
+    /// @brief The undo trail of all changes made to this state, in order.
+    std::vector<TrailEntry> trail;
+
+    /// @brief A memoized substitution result.
+    struct CachedSubstitution {
+        glu::types::TypeBase *result;
+        /// @brief The binding generation the result was computed in.
+        unsigned generation;
+        /// @brief Whether the type has no type variables, making the result
+        /// valid in every generation.
+        bool stable;
+    };
+
+    /// @brief Bumped every time typeBindings change, invalidating the
+    /// substitutions cached for the previous bindings.
+    unsigned bindingGeneration = 0;
+
+    /// @brief Substitution results of this state, keyed on the type and valid
+    /// for a single binding generation.
+    mutable llvm::DenseMap<glu::types::TypeBase *, CachedSubstitution>
+        substitutionCache;
+
     /// @brief Creates a copy of this state for branching during resolution.
+    /// The undo trail is not copied: the copy starts a new history.
     /// @return A deep copy of the current state.
-    SystemState clone() const { return *this; }
+    SystemState clone() const
+    {
+        return SystemState { _context, typeBindings, overloadChoices,
+                             implicitConversions,
+                             defaultableConstraintsSatisfied,
+                             certainConversions, {} };
+    }
+
+    /// @brief Substitutes type variables with their bindings in this state.
+    /// Results are memoized until the bindings change.
+    /// @param type The type to substitute.
+    /// @return The type with substitutions applied.
+    glu::types::Ty substitute(glu::types::Ty type) const;
+
+    /// @brief Binds a type variable to a type, recording the change.
+    void bindType(glu::types::TypeVariableTy *var, glu::types::TypeBase *type);
+
+    /// @brief Records the overload chosen for a reference expression.
+    void
+    setOverloadChoice(glu::ast::RefExpr *expr, glu::ast::FunctionDecl *decl);
+
+    /// @brief Records an implicit conversion of an expression to a type.
+    void setImplicitConversion(
+        glu::ast::ExprBase *expr, glu::types::TypeBase *type
+    );
+
+    /// @brief Counts one more satisfied defaultable constraint.
+    void addSatisfiedDefaultable();
+
+    /// @brief Returns a marker of the current point in the undo trail.
+    size_t checkpoint() const { return trail.size(); }
+
+    /// @brief Undoes every change made since the given checkpoint, in reverse
+    /// order. The cost is proportional to the number of undone changes.
+    void rollback(size_t checkpoint);
 
     /// @brief Merges this state into another, combining bindings and choices.
     /// @param other The target state to merge into.
@@ -70,6 +157,10 @@ struct SystemState {
     /// @return The score representing the number of implicit conversions.
     size_t getImplicitConversionCount() const;
 
+    /// @brief Returns a lower bound of the implicit conversion count of any
+    /// solution reachable from this state, in constant time.
+    size_t getConversionLowerBound() const { return certainConversions.size(); }
+
     /// @brief Compares two solution states for score-based ordering.
     /// @param other The other state to compare with.
     /// @return A weak ordering result based on the score of the states.
@@ -92,7 +183,8 @@ struct SolutionResult {
     /// @brief All valid solutions found.
     llvm::SmallVector<Solution, 4> solutions;
 
-    /// @brief The best solution found (the one with the lowest score).
+    /// @brief The implicit conversion count of the best solutions, computed
+    /// once when they are added.
     Score bestScore = 0;
 
     /// @brief Checks whether any solutions were found.
@@ -108,6 +200,16 @@ struct SolutionResult {
     /// @param state The system state to convert and add as a solution.
     void tryAddSolution(SystemState const &state);
 
+    /// @brief Checks whether a state may still lead to a solution at least as
+    /// good as the best one found so far. States that cannot are pruned.
+    /// @param state The partial state to check.
+    /// @return False if every solution reachable from the state is worse.
+    bool canImprove(SystemState const &state) const
+    {
+        return solutions.empty()
+            || state.getConversionLowerBound() <= bestScore;
+    }
+
     Solution *getBestSolution()
     {
         if (hasSolutions())
@@ -128,6 +230,11 @@ glu::types::Ty substitute(
     glu::ast::ASTContext *context
 );
 
+/// @brief Checks whether a type still contains unresolved type variables.
+/// @param type The type to check.
+/// @return True if a type variable appears anywhere in the type.
+bool containsTypeVariable(glu::types::TypeBase *type);
+
 /// @brief Manages type constraints and their resolution in the current context.
 class ConstraintSystem {
     // Allow visitor classes to access private methods
@@ -138,12 +245,37 @@ class ConstraintSystem {
     ScopeTable *_scopeTable; ///< The scope table for the current context.
     ast::ASTNode *_root; ///< The root AST node for replacing types.
     llvm::BumpPtrAllocator _allocator; ///< Allocator for memory management.
+    std::unique_ptr<InternedMemoryArena<types::TypeBase>>
+        _scratchTypes; ///< Types containing type variables, freed with the
+                       ///< system.
     std::vector<Constraint *>
         _constraints; ///< List of constraints to be solved.
     glu::DiagnosticManager
         &_diagManager; ///< Diagnostic manager for error reporting.
+    size_t _initialErrorCount; ///< Errors reported before this system.
     glu::ast::ASTContext
         *_context; ///< AST context to create new types after resolution.
+    SolverStatistics *_stats
+        = nullptr; ///< Where to record solver statistics, if anywhere.
+    size_t _stateBudget = 0; ///< Maximum explored states, 0 for no limit.
+    llvm::ThreadPoolInterface *_threadPool
+        = nullptr; ///< Where to solve independent components, if anywhere.
+    std::atomic<size_t> _exploredStates
+        = 0; ///< States explored by all components so far.
+    std::atomic<size_t> _peakWorklist
+        = 0; ///< Largest number of pending choice points at once.
+
+    /// @brief The overload set of an applied function or operator, and the
+    /// call site deciding which of its overloads may apply.
+    struct OverloadSet {
+        ScopeItem const *item; ///< The scope item holding the overloads.
+        OperatorOverloadIndex const
+            *operatorIndex; ///< The operator's index, null for calls.
+        glu::ast::ExprBase *application; ///< The call or operation.
+        llvm::SmallVector<glu::ast::ExprBase *, 4> args; ///< Its arguments.
+    };
+    llvm::DenseMap<Constraint const *, OverloadSet>
+        _overloadSets; ///< The disjunctions choosing applied overloads.
 
 public:
     /// @brief Constructs a ConstraintSystem.
@@ -153,13 +285,23 @@ public:
         glu::ast::ASTContext *context
     );
 
-    /// @brief Destroys the ConstraintSystem.
-    ~ConstraintSystem() = default;
+    /// @brief Destroys the ConstraintSystem, and its scratch types unless
+    /// errors reported while it existed may have left some of them in the
+    /// AST.
+    ~ConstraintSystem();
 
     /// @brief Gets the memory allocator.
     /// @return A reference to the allocator.
     llvm::BumpPtrAllocator &getAllocator() { return _allocator; }
 
+    using ScratchTypesScope
+        = InternedMemoryArena<types::TypeBase>::ScratchScope;
+
+    /// @brief Makes the current thread create the types containing type
+    /// variables in the scratch arena of this system, until the returned
+    /// scope ends. Types without type variables stay in the context's arena.
+    ScratchTypesScope useScratchTypes();
+
     /// @brief Gets the scope table.
     /// @return The current scope table.
     ScopeTable *getScopeTable() { return _scopeTable; }
@@ -167,6 +309,26 @@ public:
     ast::ASTNode *getRoot() { return _root; }
     void setRoot(ast::ASTNode *node) { _root = node; }
 
+    /// @brief Records the statistics of the next solve into the given
+    /// collector.
+    void setStatistics(SolverStatistics *stats) { _stats = stats; }
+
+    /// @brief Limits the number of states explored while solving. When the
+    /// limit is reached, the expression is reported as too complex.
+    /// @param budget The maximum number of states, or 0 for no limit.
+    void setStateBudget(size_t budget) { _stateBudget = budget; }
+
+    /// @brief Solves the independent components with several disjunctions
+    /// concurrently on the given pool, or in order on the calling thread.
+    void setThreadPool(llvm::ThreadPoolInterface *pool) { _threadPool = pool; }
+
+    /// @brief Checks whether the solver gave up after exploring too many
+    /// states.
+    bool hasExceededBudget() const
+    {
+        return _stateBudget && _exploredStates > _stateBudget;
+    }
+
     /// @brief Gets the list of constraints.
     /// @return A reference to the vector of constraints.
     std::vector<Constraint *> &getConstraints() { return _constraints; }
@@ -205,16 +367,68 @@ public:
     /// extracted.
     void mapImplicitConversions(Solution *solution);
 
-    /// @brief Solves all enabled constraints within this local constraint
-    /// system and returns the solution result through the provided parameter.
-    /// This method is called within solveConstraints, after simplification and
-    /// splitting of the constraint system, and before mapping types back to the
-    /// AST.
+    /// @brief Solves the enabled constraints of one independent component of
+    /// the constraint system and returns the solution result through the
+    /// provided parameter. This method is called within solveConstraints,
+    /// after simplification and splitting of the constraint system, and before
+    /// mapping types back to the AST.
     /// @param result The solution result to populate with found solutions.
     /// @param initialState The initial state with early unification bindings.
+    /// @param constraints The constraints of the component, in solving order.
     /// @return True if a solution was found, false otherwise.
     bool solveLocalConstraints(
-        SolutionResult &result, SystemState const &initialState
+        SolutionResult &result, SystemState const &initialState,
+        llvm::ArrayRef<Constraint *> constraints
+    );
+
+    /// @brief Splits the constraints into independent components: two
+    /// constraints are in the same component if they share a type variable,
+    /// directly or transitively. Uses a union-find over the constraints, so
+    /// this is near-linear in the total number of type variable occurrences.
+    /// @return The components, ordered by their first constraint, each
+    /// keeping the relative order of _constraints.
+    std::vector<llvm::SmallVector<Constraint *, 8>> partitionConstraints();
+
+    /// @brief Explores all resolution paths of one component and records the
+    /// solutions found, without reporting any diagnostic. Components may be
+    /// explored concurrently, as long as they are distinct.
+    ///
+    /// The search is depth-first over a single mutable state: every top-level
+    /// disjunction pushes a choice point holding a trail checkpoint, and
+    /// backtracking rolls the state back to it instead of copying the state
+    /// for each branch.
+    /// @param result The solution result to populate with found solutions.
+    /// @param initialState The initial state with early unification bindings.
+    /// @param constraints The constraints of the component, in solving order.
+    void exploreLocalConstraints(
+        SolutionResult &result, SystemState const &initialState,
+        llvm::ArrayRef<Constraint *> constraints
+    );
+
+    /// @brief Explores the resolution paths starting at a given state and
+    /// constraint index. Used by exploreLocalConstraints, and for the states
+    /// produced by disjunctions nested in other constraints.
+    /// @param result The solution result to populate with found solutions.
+    /// @param state The state to start from, modified during the search.
+    /// @param index The index of the first constraint to apply.
+    /// @param constraints The constraints of the component, in solving order.
+    /// @param depth The number of choice points pending in the callers.
+    void exploreFrom(
+        SolutionResult &result, SystemState &state, size_t index,
+        llvm::ArrayRef<Constraint *> constraints, size_t depth = 0
+    );
+
+    /// @brief Counts one more explored state against the budget.
+    /// @return False if the budget is exhausted and the search must stop.
+    bool countExploredState();
+
+    /// @brief Checks the result of exploring a component, reporting an error
+    /// if it has no solution or is ambiguous.
+    /// @param result The explored solution result.
+    /// @param constraints The constraints of the component.
+    /// @return True if there is a single best solution, false otherwise.
+    bool checkLocalSolution(
+        SolutionResult &result, llvm::ArrayRef<Constraint *> constraints
     );
 
     /// @brief Simplifies the constraint system before solving.
@@ -405,8 +619,13 @@ private:
     /// @param result The solution result containing multiple solutions.
     void reportAmbiguousSolutionError(SolutionResult const &result);
 
+    /// @brief Reports an error when the solver gave up after exploring more
+    /// states than its budget allows.
+    void reportTooComplexError();
+
     /// @brief Reports a detailed error when no solution can be found.
-    void reportNoSolutionError();
+    /// @param constraints The constraints of the component that failed.
+    void reportNoSolutionError(llvm::ArrayRef<Constraint *> constraints);
 
     /// @brief Gets a descriptive string for a type, providing context when
     /// possible.
@@ -439,7 +658,34 @@ private:
 
 private:
     // Constraint simplification passes
+    void filterOverloadChoices();
     void reorderConstraintsByPriority();
+
+    /// @brief Records the overload disjunction of an applied function or
+    /// operator, so that solving only tries the overloads that may accept
+    /// its arguments.
+    void recordOverloadSet(
+        Constraint *disjunction, glu::ast::RefExpr *ref,
+        llvm::ArrayRef<glu::ast::ExprBase *> args
+    );
+
+    /// @brief Collects the overloads of an overload disjunction that may
+    /// accept its arguments, as bound in the given state. They come from the
+    /// module's overload cache when every argument type is known, or from
+    /// the operator table when the first operand's type constructor is.
+    /// @return False if every overload must be tried.
+    bool getOverloadCandidates(
+        Constraint const *disjunction, SystemState const &state,
+        llvm::SmallPtrSetImpl<glu::ast::FunctionDecl *> &candidates
+    );
+
+    /// @brief Computes the overloads of an item that accept arguments of
+    /// the given concrete types, and whose result converts to the given
+    /// type if any.
+    OverloadCache::Candidates computeOverloadCandidates(
+        ScopeItem const &item, llvm::ArrayRef<glu::types::TypeBase *> argTypes,
+        glu::types::TypeBase *resultType
+    );
 };
 
 /// @brief Print all constraints in a ConstraintSystem for debugging.
@@ -7,11 +7,16 @@
 #include "ScopeTable.hpp"
 
 #include <llvm/Support/Allocator.h>
+#include <llvm/Support/ThreadPool.h>
+
+#include <memory>
+#include <vector>
 
 namespace glu::sema {
 
 class ImportHandler;
 struct AutoImportTemplateArg;
+struct AutoImportCommand;
 
 enum class ModuleType {
     GluModule,
@@ -68,6 +73,10 @@ class ImportManager {
     llvm::DenseMap<FileID, std::string> _generatedBitcodePaths;
     /// @brief Map of imported source files to generated object file paths.
     llvm::DenseMap<FileID, std::string> _generatedObjectPaths;
+    /// @brief The output of the compilers that failed in
+    /// prefetchForeignSources, replayed when the file is imported instead of
+    /// running the compiler again.
+    llvm::DenseMap<FileID, std::string> _failedCompilations;
     /// @brief The import paths to search for imported files.
     /// This list contains the directories that will be searched when
     /// attempting to resolve import paths. The directories are searched in
@@ -90,6 +99,57 @@ class ImportManager {
     llvm::SmallVector<ast::ImportDecl *, 4> _skippedImports;
     /// @brief Information about @implement imports for wrapper generation.
     llvm::SmallVector<ImplementImportInfo, 4> _implementImports;
+    /// @brief The files each file successfully imported. An imported module
+    /// that is linked needs all of its own imports to be linked as well.
+    llvm::DenseMap<FileID, llvm::SmallVector<FileID, 4>> _importDependencies;
+
+    /// @brief A Glu module parsed, and possibly loaded, ahead of time by
+    /// prefetchImports.
+    struct PrefetchedModule {
+        /// @brief Whether the module was parsed in the background. If not, it
+        /// is parsed again when loaded on the main thread.
+        bool parsed = false;
+        /// @brief The parsed module, or nullptr if it failed to parse.
+        ast::ModuleDecl *ast = nullptr;
+        /// @brief The diagnostics of the module, reported when it is first
+        /// imported, or nullptr once they were.
+        std::unique_ptr<DiagnosticManager> diagnostics;
+        /// @brief The Glu modules that must be loaded before this one.
+        llvm::SmallVector<FileID, 4> dependencies;
+        /// @brief Whether the module imports a file that is neither loaded
+        /// already nor a Glu module, so it must be loaded on the main thread.
+        bool blocked = false;
+        /// @brief Whether the module was loaded in the background.
+        bool loaded = false;
+    };
+    /// @brief The Glu modules prefetched by prefetchImports.
+    llvm::DenseMap<FileID, PrefetchedModule> _prefetchedModules;
+
+    /// @brief The state of a thread loading a module in the background.
+    /// What it records is merged on the main thread once it succeeded.
+    struct BackgroundLoad {
+        ImportManager *manager = nullptr;
+        /// @brief The import stack of the thread, holding the loaded module.
+        llvm::SmallVector<FileID, 8> importStack;
+        std::unique_ptr<DiagnosticManager> diagnostics;
+        llvm::SpecificBumpPtrAllocator<ScopeTable> *scopeTableAllocator
+            = nullptr;
+        llvm::SmallVector<ast::ImportDecl *, 4> skippedImports;
+        llvm::SmallVector<ImplementImportInfo, 4> implementImports;
+        llvm::SmallVector<std::pair<FileID, FileID>, 4> importDependencies;
+        /// @brief Whether the module imports a file that is not loaded yet,
+        /// in which case the main thread loads it again.
+        bool abandoned = false;
+    };
+    /// @brief The module the current thread loads in the background, if any.
+    static inline thread_local BackgroundLoad *_backgroundLoad = nullptr;
+    /// @brief The pool loading Glu modules in the background, owned by the
+    /// caller, or nullptr to load them one by one when imported.
+    llvm::ThreadPoolInterface *_threadPool = nullptr;
+    /// @brief Allocators for the scope tables of the modules loaded in the
+    /// background, one per module.
+    std::vector<std::unique_ptr<llvm::SpecificBumpPtrAllocator<ScopeTable>>>
+        _backgroundScopeTableAllocators;
 
     using LocalImportResult
         = std::optional<std::tuple<ScopeTable *, llvm::StringRef>>;
@@ -112,14 +172,26 @@ public:
         } // else, imports are invalid
     }
 
-    DiagnosticManager &getDiagnosticManager() { return _diagManager; }
+    /// @brief Returns the diagnostics of the module the current thread
+    /// loads in the background, or the main diagnostics.
+    DiagnosticManager &getDiagnosticManager()
+    {
+        if (auto *load = getBackgroundLoad()) {
+            return *load->diagnostics;
+        }
+        return _diagManager;
+    }
     ast::ASTContext &getASTContext() const { return _context; }
+    void setThreadPool(llvm::ThreadPoolInterface *pool) { _threadPool = pool; }
     SourceManager *getSourceManager() const
     {
         return _context.getSourceManager();
     }
     llvm::SpecificBumpPtrAllocator<ScopeTable> &getScopeTableAllocator()
     {
+        if (auto *load = getBackgroundLoad()) {
+            return *load->scopeTableAllocator;
+        }
         return _scopeTableAllocator;
     }
 
@@ -162,8 +234,30 @@ public:
     /// @return Returns true if the import was successful, false otherwise.
     bool handleDefaultImport(ScopeTable *intoScope);
 
+    /// @brief Resolves the imports of a module ahead of time, compiles the
+    /// foreign source files among them concurrently and, given a thread pool,
+    /// loads the Glu modules it imports, directly or not, concurrently: each
+    /// module is parsed in the background, then loaded once all the modules
+    /// it imports are.
+    /// Modules in an import cycle, or importing other kinds of files, are
+    /// left to the main thread. The imports are then handled in declaration
+    /// order as usual, reusing the prefetched modules and reporting their
+    /// diagnostics.
+    /// @param module The module whose imports should be prefetched.
+    /// @param skipPrivateImports Whether private imports are skipped for now.
+    void prefetchImports(ast::ModuleDecl *module, bool skipPrivateImports);
+
+    /// @brief Whether loading a module imports the default imports: every
+    /// module does, except the default imports themselves and IR modules.
+    /// @param module The module being loaded.
+    static bool importsDefaultImports(ast::ModuleDecl *module);
+
     void addSkippedImport(ast::ImportDecl *importDecl)
     {
+        if (auto *load = getBackgroundLoad()) {
+            load->skippedImports.push_back(importDecl);
+            return;
+        }
         _skippedImports.push_back(importDecl);
     }
 
@@ -173,11 +267,32 @@ public:
         return _implementImports;
     }
 
-    /// @brief Process all previously skipped private imports.
-    /// This should be called at the end of the compilation, if linking is
-    /// required.
-    /// @return Returns true if all imports were successful, false otherwise.
-    bool processSkippedImports();
+    /// @brief Records that a file successfully imported another file.
+    /// @param importingFile The file containing the import.
+    /// @param importedFile The file that was imported.
+    void recordImportDependency(FileID importingFile, FileID importedFile)
+    {
+        if (auto *load = getBackgroundLoad()) {
+            load->importDependencies.push_back({ importingFile, importedFile });
+            return;
+        }
+        auto &deps = _importDependencies[importingFile];
+        if (std::find(deps.begin(), deps.end(), importedFile) == deps.end()) {
+            deps.push_back(importedFile);
+        }
+    }
+
+    /// @brief Computes the imported files that must be linked, given the
+    /// modules whose symbols the main module references. Those files are
+    /// linked along with everything they import, transitively. The skipped
+    /// private imports of the files that are linked are processed on the
+    /// way; the ones of files that are never linked are never loaded.
+    /// @param referencedModules The modules declaring the referenced symbols,
+    /// in any order.
+    /// @return The files to link, in an order that only depends on the order
+    /// the files were loaded in.
+    llvm::SmallVector<FileID, 8>
+    collectLinkedFiles(llvm::ArrayRef<ast::ModuleDecl *> referencedModules);
 
     /// @brief Detects the module type from a given file ID.
     /// @param fid The FileID of the module to detect.
@@ -196,6 +311,31 @@ public:
     bool loadModule(SourceLocation importLoc, FileID fid, ModuleType type);
 
 private:
+    /// @brief Returns the module the current thread loads in the background
+    /// for this manager, or nullptr on the main thread.
+    BackgroundLoad *getBackgroundLoad() const
+    {
+        if (_backgroundLoad && _backgroundLoad->manager == this) {
+            return _backgroundLoad;
+        }
+        return nullptr;
+    }
+    /// @brief Returns the import stack of the current thread.
+    llvm::SmallVector<FileID, 8> &getImportStack()
+    {
+        if (auto *load = getBackgroundLoad()) {
+            return load->importStack;
+        }
+        return _importStack;
+    }
+    /// @brief Parses Glu modules and the Glu modules they import in the
+    /// background, then loads them concurrently in dependency order.
+    /// @param modules The Glu files imported by the module being loaded.
+    void prefetchGluModules(llvm::ArrayRef<FileID> modules);
+    /// @brief Reports the diagnostics of a prefetched module, and of the
+    /// modules it imported in the background, the first time it is imported.
+    /// @param fid The FileID of the module.
+    void reportPrefetchedDiagnostics(FileID fid);
     /// @brief Tries to select a module to import from a given file.
     /// @param importLoc The source location of the import declaration, used for
     /// diagnostics.
@@ -239,6 +379,29 @@ private:
         SourceLocation importLoc, FileID fid,
         llvm::ArrayRef<AutoImportTemplateArg> templateArgs
     );
+    /// @brief Builds the external compiler invocation for a foreign source
+    /// file, creating (and recording) its temporary output files.
+    /// @param importLoc The source location of the import declaration.
+    /// @param fid The FileID of the source file to compile.
+    /// @param templateArgs The compiler command template.
+    /// @param reportErrors Whether errors are reported, or only returned.
+    /// @return The command to run, or std::nullopt if an error occurred.
+    std::optional<AutoImportCommand> buildAutoImportCommand(
+        SourceLocation importLoc, FileID fid,
+        llvm::ArrayRef<AutoImportTemplateArg> templateArgs,
+        bool reportErrors = true
+    );
+    /// @brief Runs the compilers of multiple foreign source files
+    /// concurrently, bounded by the number of hardware threads, without
+    /// reporting anything. Successful outputs are cached so that compileToIR
+    /// only has to load them. The output of a failed compiler is captured
+    /// and its files removed, so that compileToIR reports the failure once
+    /// without compiling again. Files that could not be compiled are left to
+    /// compileToIR.
+    /// @param sources The import locations and FileIDs of the files to compile.
+    void prefetchForeignSources(
+        llvm::ArrayRef<std::pair<SourceLocation, FileID>> sources
+    );
     /// @brief Loads a module from a C source file by compiling to bitcode.
     /// @param importLoc The source location of the import declaration, used for
     /// diagnostics.
@@ -0,0 +1,75 @@
+#ifndef GLU_SEMA_OPERATORTABLE_HPP
+#define GLU_SEMA_OPERATORTABLE_HPP
+
+#include "AST/Decls.hpp"
+#include "AST/Types.hpp"
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallVector.h>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace glu::sema {
+
+struct ScopeItem;
+
+/// @brief The overloads of one operator, indexed by the type constructor of
+/// their first parameter.
+class OperatorOverloadIndex {
+    /// @brief The overloads whose first parameter has a known type
+    /// constructor.
+    llvm::DenseMap<unsigned, llvm::SmallVector<ast::FunctionDecl *, 4>>
+        _byFirstParam;
+    /// @brief The overloads that may accept any first operand (generic or
+    /// unresolved first parameter, or no parameter at all).
+    llvm::SmallVector<ast::FunctionDecl *, 4> _generic;
+    /// @brief The number of declarations of the indexed item.
+    size_t _declCount;
+
+public:
+    /// @brief Indexes the function declarations of a scope item.
+    explicit OperatorOverloadIndex(ScopeItem const &item);
+
+    /// @brief Returns the number of declarations of the item when it was
+    /// indexed.
+    size_t getDeclCount() const { return _declCount; }
+
+    /// @brief Collects the overloads that may accept a first operand of the
+    /// given type, with or without an implicit conversion.
+    /// @param operandType The type of the first operand, without type
+    /// variables at the top level.
+    /// @param candidates Where to add the candidate overloads.
+    void getCandidates(
+        types::TypeBase *operandType,
+        llvm::SmallPtrSetImpl<ast::FunctionDecl *> &candidates
+    ) const;
+};
+
+/// @brief Module-wide table of operator overloads, indexed by operator and by
+/// the type constructor of their first operand.
+///
+/// Imports copy every operator overload into the importing scope, so an
+/// operator usually has many overloads. The table lets overload resolution
+/// only try the handful of them that may accept the operands. Indexes are
+/// built the first time an operator is resolved, and can be shared between
+/// the threads checking function bodies.
+class OperatorTable {
+    std::mutex _mutex;
+    llvm::DenseMap<ScopeItem const *, std::unique_ptr<OperatorOverloadIndex>>
+        _indexes;
+    /// @brief Indexes replaced after their item gained declarations, kept
+    /// alive for the systems still using them.
+    llvm::SmallVector<std::unique_ptr<OperatorOverloadIndex>, 0> _staleIndexes;
+
+public:
+    /// @brief Returns the index of the overloads of an operator.
+    /// @param item The scope item the operator resolves to.
+    OperatorOverloadIndex const &getOverloads(ScopeItem const &item);
+};
+
+} // namespace glu::sema
+
+#endif // GLU_SEMA_OPERATORTABLE_HPP
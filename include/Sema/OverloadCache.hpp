@@ -0,0 +1,95 @@
+#ifndef GLU_SEMA_OVERLOADCACHE_HPP
+#define GLU_SEMA_OVERLOADCACHE_HPP
+
+#include "AST/Decls.hpp"
+#include "AST/Types.hpp"
+
+#include <llvm/ADT/Hashing.h>
+#include <llvm/ADT/SmallVector.h>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace glu::sema {
+
+struct ScopeItem;
+
+/// @brief Module-wide memo of overload resolution.
+///
+/// The same call shapes (e.g. `+` on two Int32, or `print` on a String)
+/// appear in many statements. Once the arguments of a call have concrete
+/// types, the overloads that can accept them only depend on the overload set
+/// and on those types, so they are computed once and shared by every
+/// statement of the module, including from the threads checking function
+/// bodies.
+class OverloadCache {
+public:
+    /// @brief A call shape: an overload set applied to arguments of concrete
+    /// types.
+    struct Key {
+        /// @brief The scope item holding the overloads.
+        ScopeItem const *overloads;
+        /// @brief The number of overloads, as items may gain some later.
+        size_t overloadCount;
+        llvm::SmallVector<types::TypeBase *, 4> argTypes;
+        /// @brief The type of the call, or null if it is not known yet.
+        types::TypeBase *resultType;
+
+        bool operator==(Key const &other) const = default;
+    };
+
+    /// @brief The overloads that may be chosen for a call shape, in
+    /// declaration order.
+    using Candidates = llvm::SmallVector<ast::FunctionDecl *, 2>;
+
+private:
+    struct KeyHash {
+        size_t operator()(Key const &key) const
+        {
+            return llvm::hash_combine(
+                key.overloads, key.overloadCount,
+                llvm::hash_combine_range(
+                    key.argTypes.begin(), key.argTypes.end()
+                ),
+                key.resultType
+            );
+        }
+    };
+
+    std::mutex _mutex;
+    /// @brief Nodes are stable, so entries can be read without the lock once
+    /// inserted.
+    std::unordered_map<Key, Candidates, KeyHash> _entries;
+
+public:
+    /// @brief Returns the candidates of a call shape, computing them the
+    /// first time it is seen.
+    /// @param key The call shape.
+    /// @param compute Computes the candidates of the call shape. It may run
+    /// concurrently for the same shape; one of the results is kept.
+    template <typename Compute>
+    Candidates const &getCandidates(Key const &key, Compute &&compute)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _entries.find(key);
+            if (it != _entries.end())
+                return it->second;
+        }
+
+        Candidates candidates = compute();
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _entries.try_emplace(key, std::move(candidates)).first->second;
+    }
+
+    /// @brief Returns the number of call shapes seen so far.
+    size_t size()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _entries.size();
+    }
+};
+
+} // namespace glu::sema
+
+#endif // GLU_SEMA_OVERLOADCACHE_HPP
@@ -7,6 +7,10 @@
 #include "AST/Decls.hpp"
 #include "AST/Stmts.hpp"
 #include "Basic/Diagnostic.hpp"
+#include "OperatorTable.hpp"
+#include "OverloadCache.hpp"
+
+#include <memory>
 
 namespace glu::sema {
 
@@ -64,6 +68,13 @@ class ScopeTable {
     /// @implement wrappers). Only the global scope has synthetic functions.
     llvm::SmallVector<ast::FunctionDecl *, 4> _syntheticFunctions;
 
+    /// @brief The operator overloads resolved in the module. Only the global
+    /// scope has an operator table.
+    std::unique_ptr<OperatorTable> _operatorTable;
+    /// @brief The overloads chosen for the call shapes of the module. Only
+    /// the global scope has an overload cache.
+    std::unique_ptr<OverloadCache> _overloadCache;
+
 public:
     /// @brief A special scope table representing the standard library
     /// namespace. This is used to resolve names in the standard library
@@ -149,6 +160,18 @@ public:
         return _syntheticFunctions;
     }
 
+    /// @brief Returns the operator table of the module this scope belongs to.
+    OperatorTable &getOperatorTable()
+    {
+        return *getGlobalScope()->_operatorTable;
+    }
+
+    /// @brief Returns the overload cache of the module this scope belongs to.
+    OverloadCache &getOverloadCache()
+    {
+        return *getGlobalScope()->_overloadCache;
+    }
+
     /// @brief Returns the function declaration this scope belongs to,
     /// or nullptr if this scope is the global scope.
     ast::FunctionDecl *getFunctionDecl();
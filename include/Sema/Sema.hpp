@@ -4,6 +4,7 @@
 #include "AST/ASTContext.hpp"
 #include "AST/ASTNode.hpp"
 #include "Basic/Diagnostic.hpp"
+#include "SolverStatistics.hpp"
 
 namespace glu::sema {
 
@@ -37,10 +38,11 @@ void constrainAST(
 /// @param module The root module declaration of the AST to be constrained.
 /// @param diagManager The diagnostic manager to report errors and warnings.
 /// @param importManager The import manager to handle import declarations.
+/// @param options The options of the constraint solver.
 /// @return Returns the scope table for the module.
 ScopeTable *constrainAST(
     glu::ast::ModuleDecl *module, glu::DiagnosticManager &diagManager,
-    ImportManager *importManager, bool dumpConstraints = false
+    ImportManager *importManager, SolverOptions const &options = {}
 );
 
 /// @brief Fast version of constrainAST that does not fully check the contents
@@ -58,7 +60,18 @@ ScopeTable *fastConstrainAST(
 
 void runLocalCSWalker(
     ScopeTable *scope, ast::ASTNode *node, glu::DiagnosticManager &diagManager,
-    glu::ast::ASTContext *context, llvm::raw_ostream *dumpConstraints
+    glu::ast::ASTContext *context, SolverOptions const &options
+);
+
+/// @brief Types a statement or declaration directly when all of its
+/// expressions are determined locally, without building a constraint system.
+/// @param scope The scope table of the node.
+/// @param node The statement or declaration to type.
+/// @param context The AST context to create types in.
+/// @return True if the node was typed, false if it needs the constraint
+/// system, in which case it is left untouched.
+bool tryFastPathTyping(
+    ScopeTable *scope, ast::ASTNode *node, glu::ast::ASTContext *context
 );
 };
 
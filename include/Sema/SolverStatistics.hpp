@@ -0,0 +1,95 @@
+#ifndef GLU_SEMA_SOLVER_STATISTICS_HPP
+#define GLU_SEMA_SOLVER_STATISTICS_HPP
+
+#include "Basic/SourceLocation.hpp"
+#include "Basic/SourceManager.hpp"
+
+#include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace glu::sema {
+
+/// @brief Statistics of one constraint system, solved for a single statement
+/// or declaration.
+struct SolverRecord {
+    /// @brief The location of the root node of the constraint system.
+    SourceLocation location = SourceLocation::invalid;
+    /// @brief The number of constraints generated.
+    size_t constraints = 0;
+    /// @brief The number of independent components solved.
+    size_t components = 0;
+    /// @brief The number of disjunction branches and nested states explored.
+    size_t exploredStates = 0;
+    /// @brief The largest number of pending choice points at once.
+    size_t peakWorklist = 0;
+    /// @brief Time spent solving the constraints.
+    std::chrono::nanoseconds time { 0 };
+};
+
+/// @brief Collects the statistics of every constraint system solved during
+/// semantic analysis, for -print-solver-stats. Records may be added from
+/// several threads.
+class SolverStatistics {
+    std::vector<SolverRecord> _records;
+    size_t _fastPathCount = 0;
+    std::mutex _mutex;
+
+public:
+    /// @brief Records the statistics of one solved constraint system.
+    void addRecord(SolverRecord const &record)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _records.push_back(record);
+    }
+
+    /// @brief Records a statement typed without a constraint system.
+    void recordFastPath()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_fastPathCount;
+    }
+
+    /// @brief Returns the number of statements typed without a constraint
+    /// system.
+    size_t getFastPathCount() const { return _fastPathCount; }
+
+    /// @brief Returns the records, in the order the systems were solved.
+    llvm::ArrayRef<SolverRecord> getRecords() const { return _records; }
+
+    /// @brief Prints the totals and the slowest expressions.
+    /// @param os The output stream to print to.
+    /// @param sourceManager The source manager to print locations with.
+    /// @param slowestCount How many of the slowest expressions to list.
+    void print(
+        llvm::raw_ostream &os, SourceManager const &sourceManager,
+        size_t slowestCount = 10
+    ) const;
+};
+
+/// @brief Options of semantic analysis and of the constraint solver, shared by
+/// every local constraint system of a module.
+struct SolverOptions {
+    /// @brief The default number of states the solver may explore for a
+    /// single statement before giving up.
+    static constexpr size_t defaultStateBudget = 100000;
+
+    /// @brief Whether to dump constraints before solving them.
+    bool dumpConstraints = false;
+    /// @brief Where to record solver statistics, if anywhere.
+    SolverStatistics *stats = nullptr;
+    /// @brief The maximum number of states explored for a single statement,
+    /// or 0 for no limit.
+    size_t stateBudget = defaultStateBudget;
+    /// @brief The pool checking function bodies and solving independent
+    /// constraint components concurrently, owned by the caller. Without one,
+    /// both happen in order on the calling thread.
+    llvm::ThreadPoolInterface *threadPool = nullptr;
+};
+
+} // namespace glu::sema
+
+#endif // GLU_SEMA_SOLVER_STATISTICS_HPP
@@ -6,10 +6,27 @@
 
 namespace glu::ast {
 
+std::atomic<ModuleDecl *> *ASTNode::getModuleCache(ASTNode *node)
+{
+    if (auto *fn = llvm::dyn_cast<FunctionDecl>(node))
+        return &fn->_module;
+    if (auto *structDecl = llvm::dyn_cast<StructDecl>(node))
+        return &structDecl->_module;
+    return nullptr;
+}
+
 ModuleDecl *ASTNode::getModule()
 {
     ASTNode *node = this;
     while (node->getParent() != nullptr) {
+        if (auto *cache = getModuleCache(node)) {
+            auto *module = cache->load(std::memory_order_relaxed);
+            if (!module) {
+                module = node->getParent()->getModule();
+                cache->store(module, std::memory_order_relaxed);
+            }
+            return module;
+        }
         node = node->getParent();
     }
     return llvm::cast<ModuleDecl>(node);
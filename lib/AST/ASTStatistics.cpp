@@ -0,0 +1,146 @@
+#include "ASTStatistics.hpp"
+#include "ASTContext.hpp"
+#include "ASTWalker.hpp"
+#include "Types.hpp"
+
+#include <llvm/Support/Format.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace glu::ast {
+
+namespace {
+
+/// @brief Returns the size of a node, its lists of children included. Other
+/// trailing storage, such as the components of a name, is not counted.
+size_t getNodeSize(ASTNode *base)
+{
+    switch (base->getKind()) {
+#define NODE_CHILD(Type, Name) (void) 0
+#define NODE_TYPEREF(Type, Name) (void) 0
+#define NODE_CHILDREN(Type, Name) \
+    (bytes += node->get##Name().size() * sizeof(Type *))
+#define NODE_KIND_(Name, Parent, ...)                     \
+case NodeKind::Name##Kind: {                              \
+    [[maybe_unused]] auto *node = llvm::cast<Name>(base); \
+    size_t bytes = sizeof(Name);                          \
+    __VA_ARGS__;                                          \
+    return bytes;                                         \
+}
+#define NODE_KIND(Name, Parent)
+#include "NodeKind.def"
+    default: llvm_unreachable("Unknown node kind.");
+    }
+}
+
+/// @brief Returns the size of a type, its trailing storage included.
+template <typename T> size_t getTypeSize(T *type)
+{
+    if constexpr (requires { type->getAllocatedSize(); })
+        return type->getAllocatedSize();
+    else
+        return sizeof(T);
+}
+
+size_t getTypeSize(types::TypeBase *type)
+{
+    switch (type->getKind()) {
+#define TYPE(NAME)                \
+case types::TypeKind::NAME##Kind: \
+    return getTypeSize(llvm::cast<types::NAME>(type));
+#include "Types/TypeKind.def"
+    }
+    llvm_unreachable("Unknown type kind.");
+}
+
+class NodeCounter : public IterativeASTWalker<NodeCounter> {
+    std::array<KindStatistics, ASTStatistics::nodeKindCount> &_nodes;
+
+public:
+    explicit NodeCounter(
+        std::array<KindStatistics, ASTStatistics::nodeKindCount> &nodes
+    )
+        : _nodes(nodes)
+    {
+    }
+
+    void beforeVisitNode(ASTNode *node)
+    {
+        auto &stats = _nodes[static_cast<size_t>(node->getKind())];
+        ++stats.count;
+        stats.bytes += getNodeSize(node);
+    }
+};
+
+constexpr char const *nodeKindNames[] = {
+#define NODE_KIND(Name, Parent) #Name,
+#define NODE_KIND_SUPER(Name, Parent) #Name "First",
+#define NODE_KIND_SUPER_END(Name) #Name "Last",
+#include "NodeKind.def"
+};
+
+constexpr char const *typeKindNames[] = {
+#define TYPE(NAME) #NAME,
+#include "Types/TypeKind.def"
+};
+
+/// @brief Prints the totals of some kinds, then each of them from the one
+/// using the most memory to the one using the least.
+template <size_t N>
+void printKinds(
+    llvm::raw_ostream &os, char const *title,
+    std::array<KindStatistics, N> const &kinds, char const *const (&names)[N]
+)
+{
+    KindStatistics total;
+    std::vector<size_t> order;
+    for (size_t i = 0; i < N; ++i) {
+        total.count += kinds[i].count;
+        total.bytes += kinds[i].bytes;
+        if (kinds[i].count)
+            order.push_back(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return kinds[a].bytes > kinds[b].bytes;
+    });
+
+    os << title << ": " << total.count << " (" << total.bytes << " bytes)\n";
+    for (size_t i : order) {
+        os << llvm::format(
+            "  %-24s %10zu %12zu bytes %8.1f%%\n", names[i], kinds[i].count,
+            kinds[i].bytes, 100.0 * kinds[i].bytes / total.bytes
+        );
+    }
+}
+
+} // namespace
+
+void ASTStatistics::addModule(ModuleDecl *module)
+{
+    NodeCounter(_nodes).visit(module);
+}
+
+void ASTStatistics::addContext(ASTContext &context)
+{
+    auto &typesArena = context.getTypesMemoryArena();
+    typesArena.forEach([this](types::TypeBase *type) {
+        auto &stats = _types[static_cast<size_t>(type->getKind())];
+        ++stats.count;
+        stats.bytes += getTypeSize(type);
+    });
+    _astArenaBytes += context.getASTMemoryArena().getBytesAllocated();
+    _typesArenaBytes += typesArena.getBytesAllocated();
+}
+
+void ASTStatistics::print(llvm::raw_ostream &os) const
+{
+    os << "=== AST statistics ===\n";
+    printKinds(os, "AST nodes", _nodes, nodeKindNames);
+    printKinds(os, "Types", _types, typeKindNames);
+    os << "AST arena:   " << _astArenaBytes
+       << " bytes allocated (nodes, tokens and strings)\n";
+    os << "Types arena: " << _typesArenaBytes << " bytes allocated\n";
+}
+
+} // namespace glu::ast
@@ -262,11 +262,17 @@ public:
 
 unsigned glu::types::TypeBase::hash() const
 {
-    return HashVisitor().visit(const_cast<TypeBase *>(this));
+    // A hash of 0 is recomputed every time, which is harmless
+    if (_hash == 0)
+        _hash = HashVisitor().visit(const_cast<TypeBase *>(this));
+    return _hash;
 }
 
 bool glu::types::TypeBase::operator==(TypeBase const &other) const
 {
+    // Structurally equal types have the same hash
+    if (_hash != 0 && other._hash != 0 && _hash != other._hash)
+        return false;
     return EqualVisitor().visit(
         const_cast<TypeBase *>(this), const_cast<TypeBase *>(&other)
     );
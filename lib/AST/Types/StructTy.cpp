@@ -40,6 +40,18 @@ public:
 
 } // namespace
 
+unsigned StructTy::getSubstitutedFieldCount(
+    glu::ast::StructDecl *decl,
+    llvm::ArrayRef<glu::types::TypeBase *> templateArgs
+)
+{
+    // The type of a struct is created before its fields are set, but it has
+    // no template arguments.
+    if (templateArgs.empty())
+        return 0;
+    return decl->getFieldCount();
+}
+
 llvm::StringRef StructTy::getName() const
 {
     return _decl->getName();
@@ -99,12 +111,36 @@ uint64_t StructTy::getAlignment() const
 TypeBase *StructTy::getSubstitutedFieldType(size_t index)
 {
     auto *field = getField(index);
+    auto *declaredType = field->getType();
     if (getTemplateArgs().empty())
-        return field->getType();
+        return declaredType;
+
+    // The entry is claimed once for a declared type, then only its claimer
+    // stores the substitution, so both halves always belong together.
+    auto &cached = getTrailingObjects<SubstitutedFieldType>()[index];
+    if (cached.declaredType.load(std::memory_order_acquire) == declaredType) {
+        if (auto *substitutedType
+            = cached.substitutedType.load(std::memory_order_acquire))
+            return substitutedType;
+    }
 
     auto *ctx = _decl->getModule()->getContext();
     TemplateParamSubstituter substituter(ctx, this);
-    return substituter.visit(field->getType());
+    auto *substitutedType = substituter.visit(declaredType);
+
+    // A type variable is only the declared type while the field's own value
+    // is being typed, and may be freed with its constraint system. If the
+    // entry already belongs to another declared type, it is left as is.
+    TypeBase *unclaimed = nullptr;
+    if (declaredType && !llvm::isa<TypeVariableTy>(declaredType)
+        && cached.declaredType.compare_exchange_strong(
+            unclaimed, declaredType, std::memory_order_acq_rel
+        )) {
+        cached.substitutedType.store(
+            substitutedType, std::memory_order_release
+        );
+    }
+    return substitutedType;
 }
 
 } // end namespace glu::types
@@ -11,9 +11,9 @@ void DiagnosticManager::addDiagnostic(
 {
     _messages.emplace_back(severity, loc, message.str(), std::move(note));
 
-    // Set the error flag if this is an error or fatal error
-    if (not _hasErrors)
-        _hasErrors = severity >= DiagnosticSeverity::Error;
+    // Count errors and fatal errors
+    if (severity >= DiagnosticSeverity::Error)
+        ++_errorCount;
 
 #if VERBOSE
     // Print the diagnostic immediately for better debugging experience
@@ -52,6 +52,16 @@ void DiagnosticManager::fatal(SourceLocation loc, llvm::Twine const &message)
     addDiagnostic(DiagnosticSeverity::Fatal, loc, std::move(message));
 }
 
+void DiagnosticManager::takeDiagnostics(DiagnosticManager &other)
+{
+    for (auto &msg : other._messages)
+        _messages.push_back(std::move(msg));
+    _errorCount += other._errorCount;
+
+    other._messages.clear();
+    other._errorCount = 0;
+}
+
 void DiagnosticManager::printDiagnostic(
     llvm::raw_ostream &os, Diagnostic const &msg
 ) const
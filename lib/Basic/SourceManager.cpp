@@ -1,6 +1,38 @@
 #include "Basic/SourceManager.hpp"
 #include "Basic/SourceLocation.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+llvm::ArrayRef<uint32_t> glu::FileLocEntry::getLineStarts() const
+{
+    if (!_lineStarts.empty() || !_buffer)
+        return _lineStarts;
+
+    llvm::StringRef buffer = _buffer->getBuffer();
+    char const *start = buffer.data();
+    char const *end = start + buffer.size();
+
+    _lineStarts.push_back(0);
+    // memchr is vectorized by the C library, so long lines are skipped many
+    // bytes at a time.
+    for (char const *pos = start;
+         (pos = static_cast<char const *>(std::memchr(pos, '\n', end - pos)));
+         ++pos) {
+        _lineStarts.push_back(pos - start + 1);
+    }
+    return _lineStarts;
+}
+
+unsigned glu::FileLocEntry::getLineIndex(uint32_t offsetInFile) const
+{
+    auto lineStarts = getLineStarts();
+    // The line starts at the last line start not after the offset.
+    return std::upper_bound(lineStarts.begin(), lineStarts.end(), offsetInFile)
+        - lineStarts.begin() - 1;
+}
+
 llvm::ErrorOr<glu::FileID>
 glu::SourceManager::loadFile(llvm::StringRef filePath, bool loadContent)
 {
@@ -57,10 +89,33 @@ glu::SourceManager::ensureContentLoaded(glu::FileID fid)
 
     _fileLocEntries[fid._id]._buffer = std::move(*buffer);
     _fileLocEntries[fid._id]._offset = fileOffset;
+    indexLoadedFile(fid);
 
     return fid;
 }
 
+void glu::SourceManager::indexLoadedFile(FileID fid)
+{
+    auto const &entry = _fileLocEntries[fid._id];
+    // Empty files contain no location.
+    if (entry.getSize() == 0)
+        return;
+
+    assert(
+        (_filesByOffset.empty()
+         || _filesByOffset.back().first < entry.getOffset())
+        && "files must be loaded in offset order"
+    );
+    _filesByOffset.emplace_back(entry.getOffset(), fid);
+
+    char const *start = entry._buffer->getBufferStart();
+    auto it = std::upper_bound(
+        _filesByBuffer.begin(), _filesByBuffer.end(), start,
+        [](char const *ptr, auto const &file) { return ptr < file.first; }
+    );
+    _filesByBuffer.insert(it, { start, fid });
+}
+
 llvm::MemoryBuffer *glu::SourceManager::getBuffer(FileID fileId) const
 {
     if (static_cast<size_t>(fileId._id) >= _fileLocEntries.size()) {
@@ -73,20 +128,33 @@ llvm::MemoryBuffer *glu::SourceManager::getBuffer(FileID fileId) const
 
 glu::FileID glu::SourceManager::getFileID(SourceLocation loc) const
 {
-    for (unsigned i = 0; i < _fileLocEntries.size(); ++i) {
-        if (isOffsetInFileID(FileID(i), loc._offset)) {
-            return FileID(i);
-        }
+    FileID last(_lastOffsetLookup.load(std::memory_order_relaxed));
+    if (isOffsetInFileID(last, loc)) {
+        return last;
+    }
+
+    // The file starts at the last start offset not after the location.
+    auto it = std::upper_bound(
+        _filesByOffset.begin(), _filesByOffset.end(), loc._offset,
+        [](uint32_t offset, auto const &file) { return offset < file.first; }
+    );
+    if (it == _filesByOffset.begin()) {
+        return FileID(-1);
     }
 
-    return FileID(-1);
+    FileID fid = std::prev(it)->second;
+    if (!isOffsetInFileID(fid, loc)) {
+        return FileID(-1);
+    }
+    _lastOffsetLookup.store(fid._id, std::memory_order_relaxed);
+    return fid;
 }
 
 bool glu::SourceManager::isOffsetInFileID(
     glu::FileID fid, SourceLocation loc
 ) const
 {
-    if (fid._id >= static_cast<int>(_fileLocEntries.size())) {
+    if (fid._id < 0 || fid._id >= static_cast<int>(_fileLocEntries.size())) {
         return false;
     }
 
@@ -112,19 +180,35 @@ glu::SourceManager::getLocForStartOfFile(FileID fileID) const
 glu::SourceLocation
 glu::SourceManager::getSourceLocFromStringRef(llvm::StringRef str) const
 {
-    for (auto const &entry : _fileLocEntries) {
-        std::optional<llvm::StringRef> bufferOpt
-            = entry.getBufferDataIfLoaded();
-        if (!bufferOpt)
-            continue;
-
-        llvm::StringRef buffer = *bufferOpt;
-        if (str.data() >= buffer.data()
-            && str.data() < buffer.data() + buffer.size()) {
-            return SourceLocation(
-                entry.getOffset() + (str.data() - buffer.data())
-            );
-        }
+    auto locationIn = [&](FileID fid) -> std::optional<SourceLocation> {
+        if (fid._id < 0)
+            return std::nullopt;
+        auto const &entry = _fileLocEntries[fid._id];
+        llvm::StringRef buffer = entry._buffer->getBuffer();
+        if (str.data() < buffer.data()
+            || str.data() >= buffer.data() + buffer.size())
+            return std::nullopt;
+        return SourceLocation(entry.getOffset() + (str.data() - buffer.data()));
+    };
+
+    FileID last(_lastBufferLookup.load(std::memory_order_relaxed));
+    if (auto loc = locationIn(last)) {
+        return *loc;
+    }
+
+    // The buffer starts at the last buffer start not after the string.
+    auto it = std::upper_bound(
+        _filesByBuffer.begin(), _filesByBuffer.end(), str.data(),
+        [](char const *ptr, auto const &file) { return ptr < file.first; }
+    );
+    if (it == _filesByBuffer.begin()) {
+        return SourceLocation(0);
+    }
+
+    FileID fid = std::prev(it)->second;
+    if (auto loc = locationIn(fid)) {
+        _lastBufferLookup.store(fid._id, std::memory_order_relaxed);
+        return *loc;
     }
     return SourceLocation(0);
 }
@@ -172,19 +256,11 @@ unsigned glu::SourceManager::getSpellingColumnNumber(SourceLocation loc) const
     if (!bufferOpt) {
         return 0;
     }
-    llvm::StringRef buffer = *bufferOpt;
 
     unsigned offsetInFile = loc._offset - entry.getOffset();
-    unsigned column = 1;
-
-    for (unsigned i = offsetInFile; i > 0; --i) {
-        if (buffer[i - 1] == '\n') {
-            break;
-        }
-        column++;
-    }
-
-    return column;
+    unsigned lineStart
+        = entry.getLineStarts()[entry.getLineIndex(offsetInFile)];
+    return offsetInFile - lineStart + 1;
 }
 
 unsigned glu::SourceManager::getSpellingLineNumber(SourceLocation loc) const
@@ -200,18 +276,9 @@ unsigned glu::SourceManager::getSpellingLineNumber(SourceLocation loc) const
     if (!bufferOpt) {
         return 0;
     }
-    llvm::StringRef buffer = *bufferOpt;
 
     unsigned offsetInFile = loc._offset - entry.getOffset();
-    unsigned line = 1;
-
-    for (unsigned i = 0; i < offsetInFile; ++i) {
-        if (buffer[i] == '\n') {
-            line++;
-        }
-    }
-
-    return line;
+    return entry.getLineIndex(offsetInFile) + 1;
 }
 
 void glu::SourceManager::loadBuffer(
@@ -225,6 +292,7 @@ void glu::SourceManager::loadBuffer(
     _fileLocEntries.emplace_back(
         fileOffset, std::move(buffer), SourceLocation(fileOffset), fileName
     );
+    indexLoadedFile(FileID(_fileLocEntries.size() - 1));
 }
 
 llvm::StringRef glu::SourceManager::getBufferName(SourceLocation loc) const
@@ -286,6 +354,10 @@ glu::SourceManager::getImportLibraryRoot(llvm::StringRef filepath) const
 void glu::SourceManager::reset()
 {
     _fileLocEntries.clear();
+    _filesByOffset.clear();
+    _filesByBuffer.clear();
+    _lastOffsetLookup = -1;
+    _lastBufferLookup = -1;
     _nextOffset = 0;
     _mainFile = FileID(0);
 }
@@ -304,18 +376,10 @@ glu::SourceLocation glu::SourceManager::getLineStart(SourceLocation loc) const
         return SourceLocation::invalid;
     }
 
-    llvm::StringRef buffer = *bufferOpt;
     unsigned offsetInFile = loc._offset - entry.getOffset();
-
-    // Find start of the line containing the location
-    char const *bufStart = buffer.data();
-    char const *pos = bufStart + offsetInFile;
-
-    while (pos > bufStart && pos[-1] != '\n') {
-        --pos;
-    }
-
-    return SourceLocation((pos - bufStart) + entry.getOffset());
+    unsigned lineStart
+        = entry.getLineStarts()[entry.getLineIndex(offsetInFile)];
+    return SourceLocation(lineStart + entry.getOffset());
 }
 
 glu::SourceLocation glu::SourceManager::getLineEnd(SourceLocation loc) const
@@ -232,7 +232,11 @@ struct GILGenExpr : public ASTVisitor<GILGenExpr, gil::Value> {
         gil::Value structValue = visit(expr->getStructExpr());
         llvm::StringRef memberName = expr->getMemberName();
         auto *structType = llvm::cast<types::StructTy>(structValue.getType());
-        gil::Member member(memberName, expr->getType(), structType);
+        auto fieldIndex = structType->getFieldIndex(memberName);
+        assert(fieldIndex && "Struct field not found");
+        gil::Member member(
+            memberName, expr->getType(), structType, *fieldIndex
+        );
 
         return ctx.buildStructExtract(structValue, member)->getResult(0);
     }
@@ -77,7 +77,9 @@ struct GILGenLValue : public ASTVisitor<GILGenLValue, gil::Value> {
         auto *memberType = expr->getType();
 
         // Create the Member object
-        gil::Member member(expr->getMemberName(), memberType, structType);
+        gil::Member member(
+            expr->getMemberName(), memberType, structType, *fieldIndex
+        );
 
         // Create and emit the StructFieldPtrInst using the context's build
         // method
@@ -241,13 +241,11 @@ struct GILGenStmt : public ASTVisitor<GILGenStmt, void> {
             = ctx.buildBitcast(elementPtrType, arrayPtr)->getResult(0);
 
         // end = begin + arraySize
-        auto sizeValue = ctx.buildIntegerLiteral(
-                                typesArena.create<types::IntTy>(
-                                    types::IntTy::Unsigned, 64
-                                ),
-                                llvm::APInt(64, arraySize)
-        )
-                             ->getResult(0);
+        auto *u64
+            = ctx.getASTContext()->getIntType(types::IntTy::Unsigned, 64);
+        auto sizeValue
+            = ctx.buildIntegerLiteral(u64, llvm::APInt(64, arraySize))
+                  ->getResult(0);
         auto endValue = ctx.buildPtrOffset(beginValue, sizeValue)->getResult(0);
 
         auto iterVar = ctx.buildAlloca(elementPtrType)->getResult(0);
@@ -276,11 +274,8 @@ struct GILGenStmt : public ASTVisitor<GILGenStmt, void> {
         auto endCmp = ctx.buildLoadCopy(endVar)->getResult(0);
 
         // Compare pointers by casting to UInt64 and using builtin_eq
-        auto *uintType
-            = typesArena.create<types::IntTy>(types::IntTy::Unsigned, 64);
-        auto iterAsInt
-            = ctx.buildCastPtrToInt(uintType, iterValue)->getResult(0);
-        auto endAsInt = ctx.buildCastPtrToInt(uintType, endCmp)->getResult(0);
+        auto iterAsInt = ctx.buildCastPtrToInt(u64, iterValue)->getResult(0);
+        auto endAsInt = ctx.buildCastPtrToInt(u64, endCmp)->getResult(0);
 
         // Use builtin_eq(UInt64, UInt64) set by sema for array iteration
         auto *eqFunc = stmt->getEqualityFunc();
@@ -315,13 +310,8 @@ struct GILGenStmt : public ASTVisitor<GILGenStmt, void> {
         // -- Step: iter = iter + 1 --
         ctx.positionAtEnd(stepBB);
         auto iterForStep = ctx.buildLoadCopy(iterVar)->getResult(0);
-        auto oneValue = ctx.buildIntegerLiteral(
-                               typesArena.create<types::IntTy>(
-                                   types::IntTy::Unsigned, 64
-                               ),
-                               llvm::APInt(64, 1)
-        )
-                            ->getResult(0);
+        auto oneValue
+            = ctx.buildIntegerLiteral(u64, llvm::APInt(64, 1))->getResult(0);
         auto nextValue
             = ctx.buildPtrOffset(iterForStep, oneValue)->getResult(0);
         ctx.buildStore(nextValue, iterVar);
@@ -509,11 +499,11 @@ gil::Function *generateGlobalDestructorFunction(
     [[maybe_unused]] GlobalContext &globalCtx
 )
 {
-    auto &typesArena = decl->getModule()->getContext()->getTypesMemoryArena();
+    auto *astContext = decl->getModule()->getContext();
+    auto &typesArena = astContext->getTypesMemoryArena();
     auto funcName = std::string(decl->getName()) + ".dtor";
     auto *funcType = typesArena.create<types::FunctionTy>(
-        llvm::ArrayRef<glu::types::TypeBase *> {},
-        typesArena.create<types::VoidTy>()
+        llvm::ArrayRef<glu::types::TypeBase *> {}, astContext->getVoidType()
     );
     auto *function = new gil::Function(funcName, funcType, nullptr);
     module->addFunction(function);
@@ -110,13 +110,8 @@ public:
     gil::Value visit(std::nullptr_t)
     {
         auto intValue = llvm::APInt(64, 0);
-        auto *u64 = _ctx.getASTFunction()
-                        ->getModule()
-                        ->getContext()
-                        ->getTypesMemoryArena()
-                        .create<glu::types::IntTy>(
-                            glu::types::IntTy(glu::types::IntTy::Unsigned, 64)
-                        );
+        auto *astContext = _ctx.getASTFunction()->getModule()->getContext();
+        auto *u64 = astContext->getIntType(glu::types::IntTy::Unsigned, 64);
 
         auto *zero = _ctx.buildIntegerLiteral(u64, intValue);
         return _ctx.buildCastIntToPtr(_type, zero->getResult(0))->getResult(0);
@@ -24,6 +24,7 @@ struct IRGenVisitor : public glu::gil::InstVisitor<IRGenVisitor> {
     TypeLowering typeLowering;
     DebugTypeLowering debugTypeLowering;
     gil::Module *gilModule;
+    llvm::SmallPtrSetImpl<ast::ModuleDecl *> *referencedModules;
 
     // Helpers
     IRGenGlobal globalVarGen;
@@ -42,17 +43,36 @@ struct IRGenVisitor : public glu::gil::InstVisitor<IRGenVisitor> {
     llvm::DenseMap<gil::Value, llvm::PHINode *> phiNodeMap;
 
     IRGenVisitor(
-        llvm::Module &module, SourceManager *sm, glu::gil::Module *gilModule
+        llvm::Module &module, SourceManager *sm, glu::gil::Module *gilModule,
+        llvm::SmallPtrSetImpl<ast::ModuleDecl *> *referencedModules
     )
         : ctx(module, sm)
         , builder(ctx.ctx)
         , typeLowering(ctx.ctx)
         , debugTypeLowering(ctx, typeLowering)
         , gilModule(gilModule)
+        , referencedModules(referencedModules)
         , globalVarGen(ctx, typeLowering)
     {
     }
 
+    /// @brief Records the module declaring a referenced symbol, so that the
+    /// driver only links the imported modules that are actually used.
+    void recordReference(ast::DeclBase *decl)
+    {
+        if (!referencedModules || !decl) {
+            return;
+        }
+        ast::ASTNode *root = decl;
+        while (root->getParent()) {
+            root = root->getParent();
+        }
+        // Builtins have no parent module
+        if (auto *module = llvm::dyn_cast<ast::ModuleDecl>(root)) {
+            referencedModules->insert(module);
+        }
+    }
+
     // MARK: Create Function
 
     llvm::Function *createOrGetFunction(glu::gil::Function *fn)
@@ -62,6 +82,8 @@ struct IRGenVisitor : public glu::gil::InstVisitor<IRGenVisitor> {
             return it->second;
         }
 
+        recordReference(fn->getDecl());
+
         // Source loc
         SourceLocation loc = SourceLocation::invalid;
         if (fn->getDecl()) {
@@ -427,6 +449,9 @@ struct IRGenVisitor : public glu::gil::InstVisitor<IRGenVisitor> {
                 // Get length of the string
                 int length = inst->getValue().size();
 
+                // The runtime function lives next to the String type
+                recordReference(structTy->getDecl());
+
                 // Find or create the createConstantString function
                 llvm::Function *createFn
                     = ctx.outModule.getFunction("glu_createConstantString");
@@ -475,6 +500,7 @@ struct IRGenVisitor : public glu::gil::InstVisitor<IRGenVisitor> {
     void visitGlobalPtrInst(glu::gil::GlobalPtrInst *inst)
     {
         gil::Global *globalVar = inst->getGlobal();
+        recordReference(globalVar->getDecl());
         // First call the accessor function if it exists
         if (llvm::Function *accessor = globalVarGen.getAccessor(globalVar)) {
             builder.CreateCall(accessor);
@@ -489,9 +515,7 @@ struct IRGenVisitor : public glu::gil::InstVisitor<IRGenVisitor> {
         auto member = inst->getMember();
         auto enumTy = llvm::cast<glu::types::EnumTy>(member.getParent());
 
-        auto variantIndexOpt = enumTy->getFieldIndex(member.getName());
-        assert(variantIndexOpt.has_value() && "Enum variant not found");
-        auto *field = enumTy->getField(variantIndexOpt.value());
+        auto *field = enumTy->getField(member.getIndex());
         auto *literal = llvm::dyn_cast<ast::LiteralExpr>(field->getValue());
         assert(literal && "Enum case value must be resolved by Sema");
         auto literalValue = literal->getValue();
@@ -933,14 +957,19 @@ struct IRGenVisitor : public glu::gil::InstVisitor<IRGenVisitor> {
 
     // - MARK: Aggregate Instructions
 
-    // Helper function to get field index from struct type and member name
+    // Helper function to get the field index GILGen resolved for a member
     uint32_t getStructFieldIndexOrAssert(
-        glu::types::StructTy *structTy, llvm::StringRef fieldName
+        [[maybe_unused]] glu::types::StructTy *structTy,
+        glu::gil::Member const &member
     )
     {
-        auto fieldIndexOpt = structTy->getFieldIndex(fieldName);
-        assert(fieldIndexOpt.has_value() && "Field not found in struct");
-        return static_cast<uint32_t>(fieldIndexOpt.value());
+        assert(
+            member.getIndex() < structTy->getFieldCount()
+            && structTy->getField(member.getIndex())->getName()
+                == member.getName()
+            && "Field not found in struct"
+        );
+        return member.getIndex();
     }
 
     void visitStructExtractInst(glu::gil::StructExtractInst *inst)
@@ -951,7 +980,7 @@ struct IRGenVisitor : public glu::gil::InstVisitor<IRGenVisitor> {
 
         auto structTy = llvm::cast<glu::types::StructTy>(structValue.getType());
         uint32_t fieldIndex
-            = getStructFieldIndexOrAssert(structTy, member.getName());
+            = getStructFieldIndexOrAssert(structTy, member);
 
         llvm::Value *result = builder.CreateExtractValue(structVal, fieldIndex);
         mapValue(inst->getResult(0), result);
@@ -997,7 +1026,7 @@ struct IRGenVisitor : public glu::gil::InstVisitor<IRGenVisitor> {
 
         auto structTy = llvm::cast<glu::types::StructTy>(member.getParent());
         uint32_t fieldIndex
-            = getStructFieldIndexOrAssert(structTy, member.getName());
+            = getStructFieldIndexOrAssert(structTy, member);
 
         // Create GEP instruction to get field pointer
         llvm::Value *indices[] = {
@@ -1087,10 +1116,11 @@ struct IRGenVisitor : public glu::gil::InstVisitor<IRGenVisitor> {
 };
 
 void IRGen::generateIR(
-    llvm::Module &out, glu::gil::Module *mod, SourceManager *sourceManager
+    llvm::Module &out, glu::gil::Module *mod, SourceManager *sourceManager,
+    llvm::SmallPtrSetImpl<ast::ModuleDecl *> *referencedModules
 )
 {
-    IRGenVisitor visitor(out, sourceManager, mod);
+    IRGenVisitor visitor(out, sourceManager, mod, referencedModules);
     // Visit the module to generate IR
     visitor.visit(mod);
 }
@@ -24,9 +24,7 @@ public:
         auto *astCtx = func->getDecl()->getModule()->getContext();
         auto &astTyMemArena = astCtx->getTypesMemoryArena();
 
-        auto *newRetType = astTyMemArena.create<types::IntTy>(
-            types::IntTy(types::IntTy::Signed, 32)
-        );
+        auto *newRetType = astCtx->getIntType(types::IntTy::Signed, 32);
         auto *newFuncType = astTyMemArena.create<types::FunctionTy>(
             func->getType()->getParameters(), newRetType,
             func->getDecl()->getType()->isCVariadic()
@@ -12,8 +12,11 @@
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IRReader/IRReader.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/Path.h>
 #include <llvm/Support/Program.h>
+#include <llvm/Support/Threading.h>
+#include <llvm/Support/raw_ostream.h>
 #include <llvm/TargetParser/Host.h>
 
 namespace glu::sema {
@@ -104,16 +107,36 @@ static AutoImportTemplateArg D_TEMPLATE[]
         "-of=",
         AutoImportTemplateArg::OutputIRFile };
 
-bool ImportManager::compileToIR(
-    SourceLocation importLoc, FileID fid,
-    llvm::ArrayRef<AutoImportTemplateArg> templateArgs
-)
+/// @brief A fully resolved external compiler invocation for an auto-imported
+/// source file.
+struct AutoImportCommand {
+    /// @brief The absolute path of the compiler executable.
+    std::string compilerPath;
+    /// @brief The arguments to pass to the compiler, including argv[0].
+    llvm::SmallVector<std::string, 12> args;
+    /// @brief The path where the compiler writes the LLVM IR, if any.
+    std::string outputIRFile;
+};
+
+static llvm::ArrayRef<AutoImportTemplateArg>
+getAutoImportTemplate(ModuleType type)
 {
-    auto cachedPath = _generatedBitcodePaths.find(fid);
-    if (cachedPath != _generatedBitcodePaths.end()) {
-        return loadIRModuleFromPath(importLoc, fid, cachedPath->second);
+    switch (type) {
+    case ModuleType::CSource:
+    case ModuleType::CxxSource: return CLANG_TEMPLATE;
+    case ModuleType::RustSource: return RUST_TEMPLATE;
+    case ModuleType::ZigSource: return ZIG_TEMPLATE;
+    case ModuleType::SwiftSource: return SWIFT_TEMPLATE;
+    case ModuleType::DSource: return D_TEMPLATE;
+    default: return {};
     }
+}
 
+std::optional<AutoImportCommand> ImportManager::buildAutoImportCommand(
+    SourceLocation importLoc, FileID fid,
+    llvm::ArrayRef<AutoImportTemplateArg> templateArgs, bool reportErrors
+)
+{
     auto *sm = _context.getSourceManager();
     llvm::StringRef sourcePath = sm->getBufferName(fid);
 
@@ -124,12 +147,15 @@ bool ImportManager::compileToIR(
     auto compilerName = templateArgs[0].content;
     auto compilerPath = llvm::sys::findProgramByName(compilerName);
     if (!compilerPath) {
-        _diagManager.error(
+        if (reportErrors) {
+            _diagManager.error(
             importLoc,
-            "Could not find " + compilerName.str() + " to compile '"
-                + sourcePath.str() + "': " + compilerPath.getError().message()
-        );
-        return false;
+                "Could not find " + compilerName.str() + " to compile '"
+                    + sourcePath.str()
+                    + "': " + compilerPath.getError().message()
+            );
+        }
+        return std::nullopt;
     }
 
     AutoImportConfig config = {
@@ -150,12 +176,14 @@ bool ImportManager::compileToIR(
             // llvm::sys::fs::remove(linkerTempPath); // will be created by
             // linker
             if (lec) {
-                _diagManager.error(
-                    importLoc,
-                    "Failed to create temporary file for linker output: "
-                        + lec.message()
-                );
-                return false;
+                if (reportErrors) {
+                    _diagManager.error(
+                        importLoc,
+                        "Failed to create temporary file for linker output: "
+                            + lec.message()
+                    );
+                }
+                return std::nullopt;
             }
             config.outputLinkerFile = linkerTempPath.str();
             _generatedObjectPaths[fid] = config.outputLinkerFile;
@@ -167,12 +195,14 @@ bool ImportManager::compileToIR(
                 "glu-import-ir", "ll", tempPath
             );
             if (ec) {
-                _diagManager.error(
-                    importLoc,
-                    "Failed to create temporary file for IR output: "
-                        + ec.message()
-                );
-                return false;
+                if (reportErrors) {
+                    _diagManager.error(
+                        importLoc,
+                        "Failed to create temporary file for IR output: "
+                            + ec.message()
+                    );
+                }
+                return std::nullopt;
             }
             config.outputIRFile = tempPath.str();
             _generatedBitcodePaths[fid] = config.outputIRFile;
@@ -180,27 +210,60 @@ bool ImportManager::compileToIR(
         compilerArgs.push_back(arg.resolve(config));
     }
 
-    llvm::SmallVector<std::string> _retain;
+    AutoImportCommand command;
+    command.compilerPath = *compilerPath;
+    command.outputIRFile = config.outputIRFile;
     // Handle arguments ending with '=' that need to be merged with the next arg
-    llvm::SmallVector<llvm::StringRef, 12> args;
     for (std::size_t i = 0; i < compilerArgs.size(); ++i) {
         auto arg = compilerArgs[i];
         if (arg.ends_with("=") && i + 1 < compilerArgs.size()) {
-            _retain.push_back((arg + compilerArgs[i + 1]).str());
-            args.push_back(_retain.back());
+            command.args.push_back((arg + compilerArgs[i + 1]).str());
             ++i; // skip next arg
         } else {
-            args.push_back(arg);
+            command.args.push_back(arg.str());
         }
     }
+    return command;
+}
 
+bool ImportManager::compileToIR(
+    SourceLocation importLoc, FileID fid,
+    llvm::ArrayRef<AutoImportTemplateArg> templateArgs
+)
+{
+    auto cachedPath = _generatedBitcodePaths.find(fid);
+    if (cachedPath != _generatedBitcodePaths.end()) {
+        return loadIRModuleFromPath(importLoc, fid, cachedPath->second);
+    }
+    auto failedCompilation = _failedCompilations.find(fid);
+    if (failedCompilation != _failedCompilations.end()) {
+        // The compiler already failed in prefetchForeignSources: print what
+        // it would have printed instead of running it again.
+        llvm::errs() << failedCompilation->second;
+        _failedCompilations.erase(failedCompilation);
+        _diagManager.error(
+            importLoc,
+            "Failed to compile source file: "
+                + _context.getSourceManager()->getBufferName(fid)
+        );
+        return false;
+    }
+
+    auto command = buildAutoImportCommand(importLoc, fid, templateArgs);
+    if (!command) {
+        return false;
+    }
+
+    llvm::SmallVector<llvm::StringRef, 12> args(
+        command->args.begin(), command->args.end()
+    );
     std::string errorMsg;
     int result = llvm::sys::ExecuteAndWait(
-        *compilerPath, args, std::nullopt, {}, 0, 0, &errorMsg
+        command->compilerPath, args, std::nullopt, {}, 0, 0, &errorMsg
     );
     if (result != 0) {
-        std::string message
-            = "Failed to compile source file: " + sourcePath.str();
+        std::string message = "Failed to compile source file: "
+            + _context.getSourceManager()->getBufferName(fid).str();
         if (!errorMsg.empty()) {
             message += ": " + errorMsg;
         }
@@ -208,10 +271,99 @@ bool ImportManager::compileToIR(
         return false;
     }
 
-    if (config.outputIRFile.empty()) {
+    if (command->outputIRFile.empty()) {
         return true; // skip (unused for now)
     }
-    return loadIRModuleFromPath(importLoc, fid, config.outputIRFile);
+    return loadIRModuleFromPath(importLoc, fid, command->outputIRFile);
+}
+
+void ImportManager::prefetchForeignSources(
+    llvm::ArrayRef<std::pair<SourceLocation, FileID>> sources
+)
+{
+    struct RunningJob {
+        FileID fid;
+        llvm::sys::ProcessInfo process;
+        /// @brief The file capturing the output of the compiler.
+        std::string outputPath;
+    };
+
+    unsigned maxJobs = llvm::hardware_concurrency().compute_thread_count();
+    llvm::SmallVector<RunningJob, 8> running;
+
+    // Removes the outputs of a file that is not compiled by the prefetch.
+    auto discard = [this](FileID fid) {
+        for (auto *paths :
+             { &_generatedBitcodePaths, &_generatedObjectPaths }) {
+            auto it = paths->find(fid);
+            if (it != paths->end()) {
+                llvm::sys::fs::remove(it->second);
+                paths->erase(it);
+            }
+        }
+    };
+    auto waitFor = [&](RunningJob &job) {
+        auto status = llvm::sys::Wait(job.process, std::nullopt);
+        if (status.ReturnCode != 0) {
+            auto output = llvm::MemoryBuffer::getFile(job.outputPath);
+            _failedCompilations[job.fid]
+                = output ? (*output)->getBuffer().str() : "";
+            discard(job.fid);
+        }
+        llvm::sys::fs::remove(job.outputPath);
+    };
+
+    for (auto [importLoc, fid] : sources) {
+        if (_generatedBitcodePaths.count(fid)
+            || _failedCompilations.count(fid)) {
+            continue; // Already compiled (or being compiled)
+        }
+        // Nothing is reported here: files that cannot be compiled in the
+        // background are compiled again when imported, which reports why.
+        auto templateArgs = getAutoImportTemplate(detectModuleType(fid));
+        if (templateArgs.empty()) {
+            continue;
+        }
+        auto command
+            = buildAutoImportCommand(importLoc, fid, templateArgs, false);
+        if (!command) {
+            discard(fid);
+            continue;
+        }
+        // The output of the compiler is captured, not to interleave with the
+        // other jobs, and printed if the import fails.
+        llvm::SmallString<128> outputPath;
+        if (llvm::sys::fs::createTemporaryFile(
+                "glu-import-output", "txt", outputPath
+            )) {
+            discard(fid);
+            continue;
+        }
+        if (running.size() >= maxJobs) {
+            waitFor(running.front());
+            running.erase(running.begin());
+        }
+        llvm::SmallVector<llvm::StringRef, 12> args(
+            command->args.begin(), command->args.end()
+        );
+        std::optional<llvm::StringRef> redirects[]
+            = { std::nullopt, outputPath.str(), outputPath.str() };
+        bool failed = false;
+        auto process = llvm::sys::ExecuteNoWait(
+            command->compilerPath, args, std::nullopt, redirects, 0, nullptr,
+            &failed
+        );
+        if (failed) {
+            discard(fid);
+            llvm::sys::fs::remove(outputPath);
+            continue;
+        }
+        running.push_back(RunningJob { fid, process, outputPath.str().str() });
+    }
+
+    for (auto &job : running) {
+        waitFor(job);
+    }
 }
 
 bool ImportManager::loadCSource(SourceLocation importLoc, FileID fid)
@@ -1,7 +1,10 @@
 #include "ConstraintSystem.hpp"
 
+#include "AST/Expr/BinaryOpExpr.hpp"
 #include "AST/Expr/CallExpr.hpp"
+#include "AST/Expr/LiteralExpr.hpp"
 #include "AST/Expr/RefExpr.hpp"
+#include "AST/Expr/UnaryOpExpr.hpp"
 #include "AST/Types/FunctionTy.hpp"
 #include "AST/Types/TypeVariableTy.hpp"
 
@@ -14,11 +17,293 @@ SystemState ConstraintSystem::simplifyConstraints()
     // Create initial state for simplification
     SystemState initialState(_context);
 
+    filterOverloadChoices();
     reorderConstraintsByPriority();
 
     return initialState;
 }
 
+/// @brief How well an overload matches its call site, as far as can be told
+/// before solving.
+enum class OverloadMatch {
+    /// @brief The overload can never be chosen.
+    Impossible,
+    /// @brief The overload may be chosen, possibly with conversions.
+    Viable,
+    /// @brief Every argument already has the type of its parameter.
+    Exact
+};
+
+/// @brief Collects the arguments applied to a function reference, if it is the
+/// callee of a call or the operator of an operation.
+/// @return False if the reference is not applied (e.g. taken as a pointer).
+static bool getAppliedArguments(
+    glu::ast::RefExpr *ref, llvm::SmallVectorImpl<glu::ast::ExprBase *> &args
+)
+{
+    auto *parent = ref->getParent();
+    if (auto *call = llvm::dyn_cast_or_null<glu::ast::CallExpr>(parent)) {
+        if (call->getCallee() != ref)
+            return false;
+        args.append(call->getArgs().begin(), call->getArgs().end());
+        return true;
+    }
+    if (auto *binary = llvm::dyn_cast_or_null<glu::ast::BinaryOpExpr>(parent)) {
+        if (binary->getOperator() != ref)
+            return false;
+        args.push_back(binary->getLeftOperand());
+        args.push_back(binary->getRightOperand());
+        return true;
+    }
+    if (auto *unary = llvm::dyn_cast_or_null<glu::ast::UnaryOpExpr>(parent)) {
+        if (unary->getOperator() != ref)
+            return false;
+        args.push_back(unary->getOperand());
+        return true;
+    }
+    return false;
+}
+
+/// @brief Matches a literal argument against a concrete parameter type. A
+/// literal takes a type expressible by its kind, which must then implicitly
+/// convert to the parameter.
+static OverloadMatch
+matchLiteral(glu::ast::LiteralExpr *literal, glu::types::TypeBase *paramTy)
+{
+    return std::visit(
+        [paramTy](auto &&value) {
+            using T = std::decay_t<decltype(value)>;
+
+            if constexpr (std::is_same_v<T, llvm::APInt>) {
+                if (llvm::isa<glu::types::IntTy, glu::types::FloatTy>(paramTy))
+                    return OverloadMatch::Exact;
+                // Through an 8-bit integer
+                if (llvm::isa<glu::types::CharTy>(paramTy))
+                    return OverloadMatch::Viable;
+                return OverloadMatch::Impossible;
+            } else if constexpr (std::is_same_v<T, llvm::APFloat>) {
+                return llvm::isa<glu::types::FloatTy>(paramTy)
+                    ? OverloadMatch::Exact
+                    : OverloadMatch::Impossible;
+            } else if constexpr (std::is_same_v<T, bool>) {
+                return llvm::isa<glu::types::BoolTy>(paramTy)
+                    ? OverloadMatch::Exact
+                    : OverloadMatch::Impossible;
+            } else {
+                // Strings and null convert to many pointer types
+                return OverloadMatch::Viable;
+            }
+        },
+        literal->getValue()
+    );
+}
+
+/// @brief Whether a function can be applied to the given number of arguments,
+/// with the same arity rules as function type conversions.
+static bool
+acceptsArgumentCount(glu::types::FunctionTy *fnTy, size_t argCount)
+{
+    if (fnTy->isCVariadic())
+        return argCount >= fnTy->getParameterCount();
+    return argCount >= fnTy->getRequiredParameterCount()
+        && argCount <= fnTy->getParameterCount();
+}
+
+/// @brief Matches an overload against the arguments of its call site.
+static OverloadMatch matchOverload(
+    ConstraintSystem &cs, glu::ast::ASTContext *context,
+    glu::types::FunctionTy *fnTy, llvm::ArrayRef<glu::ast::ExprBase *> args
+)
+{
+    if (!acceptsArgumentCount(fnTy, args.size()))
+        return OverloadMatch::Impossible;
+
+    // Nothing is bound yet: substituting only resolves type aliases
+    SystemState scratch(context);
+    OverloadMatch match = args.size() == fnTy->getParameterCount()
+        ? OverloadMatch::Exact
+        : OverloadMatch::Viable;
+    for (size_t i = 0; i < args.size() && i < fnTy->getParameterCount(); ++i) {
+        auto *paramTy = scratch.substitute(fnTy->getParameter(i));
+        auto *argTy = scratch.substitute(args[i]->getType());
+        if (containsTypeVariable(paramTy)) {
+            match = OverloadMatch::Viable;
+            continue;
+        }
+
+        OverloadMatch argMatch = OverloadMatch::Viable;
+        if (!containsTypeVariable(argTy)) {
+            if (argTy == paramTy)
+                argMatch = OverloadMatch::Exact;
+            else if (!cs.isValidConversion(argTy, paramTy, scratch, false))
+                argMatch = OverloadMatch::Impossible;
+        } else if (auto *literal
+                   = llvm::dyn_cast<glu::ast::LiteralExpr>(args[i])) {
+            argMatch = matchLiteral(literal, paramTy);
+        }
+
+        if (argMatch == OverloadMatch::Impossible)
+            return OverloadMatch::Impossible;
+        match = std::min(match, argMatch);
+    }
+    return match;
+}
+
+void ConstraintSystem::filterOverloadChoices()
+{
+    for (auto *&constraint : _constraints) {
+        if (constraint->getKind() != ConstraintKind::Disjunction)
+            continue;
+        auto *locator = constraint->getLocator();
+        auto *ref = llvm::dyn_cast_or_null<glu::ast::RefExpr>(locator);
+        llvm::SmallVector<glu::ast::ExprBase *, 4> args;
+        if (!ref || !getAppliedArguments(ref, args))
+            continue;
+
+        // Drop the overloads that cannot match, and try exact matches first
+        // so that the first solution found is usually the best one.
+        llvm::SmallVector<Constraint *, 4> exact, viable;
+        auto branches = constraint->getNestedConstraints();
+        for (auto *branch : branches) {
+            auto *fnTy = branch->getKind() == ConstraintKind::BindOverload
+                ? llvm::dyn_cast<glu::types::FunctionTy>(
+                      branch->getOverloadChoice()->getType()
+                  )
+                : nullptr;
+            OverloadMatch match = fnTy
+                ? matchOverload(*this, _context, fnTy, args)
+                : OverloadMatch::Viable;
+            if (match == OverloadMatch::Exact)
+                exact.push_back(branch);
+            else if (match == OverloadMatch::Viable)
+                viable.push_back(branch);
+        }
+
+        // Keep every choice if none can match, for diagnostics
+        exact.append(viable.begin(), viable.end());
+        if (!exact.empty() && !llvm::equal(exact, branches)) {
+            constraint = Constraint::createDisjunction(
+                _allocator, exact, ref, /*rememberChoice=*/false
+            );
+        }
+
+        recordOverloadSet(constraint, ref, args);
+    }
+}
+
+void ConstraintSystem::recordOverloadSet(
+    Constraint *disjunction, glu::ast::RefExpr *ref,
+    llvm::ArrayRef<glu::ast::ExprBase *> args
+)
+{
+    auto *item = _scopeTable->lookupItem(ref->getIdentifiers());
+    if (!item)
+        return;
+
+    auto *application = llvm::cast<glu::ast::ExprBase>(ref->getParent());
+    OperatorOverloadIndex const *operatorIndex = nullptr;
+    if (llvm::isa<glu::ast::BinaryOpExpr, glu::ast::UnaryOpExpr>(application))
+        operatorIndex = &_scopeTable->getOperatorTable().getOverloads(*item);
+
+    _overloadSets[disjunction] = { item, operatorIndex, application,
+                                   { args.begin(), args.end() } };
+}
+
+bool ConstraintSystem::getOverloadCandidates(
+    Constraint const *disjunction, SystemState const &state,
+    llvm::SmallPtrSetImpl<glu::ast::FunctionDecl *> &candidates
+)
+{
+    auto it = _overloadSets.find(disjunction);
+    if (it == _overloadSets.end())
+        return false;
+    auto &overloadSet = it->second;
+
+    OverloadCache::Key key { overloadSet.item, overloadSet.item->decls.size(),
+                             {}, nullptr };
+    bool concreteArgs = true;
+    for (auto *arg : overloadSet.args) {
+        auto *argTy = state.substitute(arg->getType());
+        concreteArgs = concreteArgs && !containsTypeVariable(argTy);
+        key.argTypes.push_back(argTy);
+    }
+
+    if (concreteArgs) {
+        auto *resultTy
+            = state.substitute(overloadSet.application->getType());
+        if (!containsTypeVariable(resultTy))
+            key.resultType = resultTy;
+
+        auto &cached = _scopeTable->getOverloadCache().getCandidates(
+            key,
+            [&] {
+                return computeOverloadCandidates(
+                    *overloadSet.item, key.argTypes, key.resultType
+                );
+            }
+        );
+        candidates.insert(cached.begin(), cached.end());
+        return true;
+    }
+
+    if (!overloadSet.operatorIndex
+        || llvm::isa<glu::types::TypeVariableTy>(key.argTypes.front()))
+        return false;
+    overloadSet.operatorIndex->getCandidates(key.argTypes.front(), candidates);
+    return true;
+}
+
+/// @brief Whether an overload accepts arguments of the given concrete types,
+/// and returns a type that converts to the call's type if it is known.
+static bool acceptsCall(
+    ConstraintSystem &cs, glu::ast::ASTContext *context,
+    glu::types::FunctionTy *fnTy,
+    llvm::ArrayRef<glu::types::TypeBase *> argTypes,
+    glu::types::TypeBase *resultType
+)
+{
+    if (!acceptsArgumentCount(fnTy, argTypes.size()))
+        return false;
+
+    // Nothing is bound: substituting only resolves type aliases
+    SystemState scratch(context);
+    for (size_t i = 0; i < argTypes.size() && i < fnTy->getParameterCount();
+         ++i) {
+        auto *paramTy = scratch.substitute(fnTy->getParameter(i));
+        if (!containsTypeVariable(paramTy)
+            && !cs.isValidConversion(argTypes[i], paramTy, scratch, false))
+            return false;
+    }
+
+    if (!resultType)
+        return true;
+    auto *returnTy = scratch.substitute(fnTy->getReturnType());
+    return containsTypeVariable(returnTy)
+        || cs.isValidConversion(returnTy, resultType, scratch, false);
+}
+
+OverloadCache::Candidates ConstraintSystem::computeOverloadCandidates(
+    ScopeItem const &item, llvm::ArrayRef<glu::types::TypeBase *> argTypes,
+    glu::types::TypeBase *resultType
+)
+{
+    OverloadCache::Candidates candidates;
+    for (auto const &decl : item.decls) {
+        auto *fnDecl = llvm::dyn_cast<glu::ast::FunctionDecl>(decl.item);
+        if (!fnDecl)
+            continue;
+
+        // Same rules as the conversion of the overload to the call's type.
+        // Generic overloads are instantiated while solving, keep them.
+        auto *fnTy = fnDecl->getType();
+        if (!fnDecl->getTemplateParams()
+            && !acceptsCall(*this, _context, fnTy, argTypes, resultType))
+            continue;
+        candidates.push_back(fnDecl);
+    }
+    return candidates;
+}
+
 enum class ConstraintPriority : unsigned {
     // Priority 0: Immediate - simple deterministic bindings
     Immediate = 0,
@@ -6,6 +6,11 @@
 #include "AST/Types.hpp"
 #include "TyMapperVisitor.hpp"
 
+#include <llvm/ADT/ScopeExit.h>
+#include <llvm/Support/ThreadPool.h>
+
+#include <chrono>
+
 namespace glu::sema {
 
 ConstraintSystem::ConstraintSystem(
@@ -15,11 +20,29 @@ ConstraintSystem::ConstraintSystem(
     : _scopeTable(scopeTable)
     , _root(scopeTable->getNode())
     , _allocator()
+    // Only the thread solving this system creates scratch types.
+    , _scratchTypes(std::make_unique<InternedMemoryArena<types::TypeBase>>(0))
     , _diagManager(diagManager)
+    , _initialErrorCount(diagManager.getErrorCount())
     , _context(context)
 {
 }
 
+ConstraintSystem::~ConstraintSystem()
+{
+    // Unsolved or unresolved expressions keep their type variables. Errors
+    // reported before this system existed did not leave any of its types.
+    if (_diagManager.getErrorCount() != _initialErrorCount)
+        _context->retainTypesArena(std::move(_scratchTypes));
+}
+
+ConstraintSystem::ScratchTypesScope ConstraintSystem::useScratchTypes()
+{
+    return ScratchTypesScope(
+        _context->getTypesMemoryArena(), *_scratchTypes, containsTypeVariable
+    );
+}
+
 void ConstraintSystem::mapOverloadChoices(Solution *solution)
 {
     for (auto &pair : solution->overloadChoices) {
@@ -147,45 +170,185 @@ void ConstraintSystem::mapImplicitConversions(Solution *solution)
 }
 
 bool ConstraintSystem::solveLocalConstraints(
-    SolutionResult &result, SystemState const &initialState
+    SolutionResult &result, SystemState const &initialState,
+    llvm::ArrayRef<Constraint *> constraints
+)
+{
+    exploreLocalConstraints(result, initialState, constraints);
+    return checkLocalSolution(result, constraints);
+}
+
+void ConstraintSystem::exploreLocalConstraints(
+    SolutionResult &result, SystemState const &initialState,
+    llvm::ArrayRef<Constraint *> constraints
 )
 {
     /// The initial system state with early unification bindings applied
-    std::vector<std::pair<SystemState, size_t>> worklist;
-    worklist.push_back({ initialState, 0 }); // Start from the simplified state
+    SystemState state = initialState.clone();
+    exploreFrom(result, state, 0, constraints);
+}
+
+/// @brief Raises an atomic maximum to the given value.
+static void updatePeak(std::atomic<size_t> &peak, size_t value)
+{
+    size_t current = peak;
+    while (current < value && !peak.compare_exchange_weak(current, value)) { }
+}
 
-    while (!worklist.empty()) {
-        SystemState current = std::move(worklist.back().first);
-        size_t index = worklist.back().second;
-        worklist.pop_back();
+bool ConstraintSystem::countExploredState()
+{
+    size_t explored = ++_exploredStates;
+    return !_stateBudget || explored <= _stateBudget;
+}
+
+void ConstraintSystem::exploreFrom(
+    SolutionResult &result, SystemState &state, size_t index,
+    llvm::ArrayRef<Constraint *> constraints, size_t depth
+)
+{
+    /// A top-level disjunction with branches left to explore.
+    struct ChoicePoint {
+        /// The index of the disjunction in the constraint list.
+        size_t index;
+        /// The index of the next branch to try.
+        size_t nextBranch;
+        /// The trail position to roll back to before each branch.
+        size_t checkpoint;
+        /// Whether any branch could be applied so far.
+        bool anyViable;
+        /// Whether a branch was satisfied without changing the state. Other
+        /// such branches would only explore the same state again.
+        bool anySatisfied;
+        /// Whether only the overloads in candidates may be chosen.
+        bool onlyCandidates = false;
+        /// The overloads that may accept the arguments of the applied
+        /// function or operator, as bound when the choice point was created.
+        llvm::SmallPtrSet<glu::ast::FunctionDecl *, 8> candidates;
+
+        /// Whether a branch may be chosen.
+        bool admits(Constraint const *branch) const
+        {
+            return !onlyCandidates
+                || branch->getKind() != ConstraintKind::BindOverload
+                || candidates.contains(branch->getOverloadChoice());
+        }
+    };
+    std::vector<ChoicePoint> choicePoints;
 
-        while (index < _constraints.size()) {
-            Constraint *constraint = _constraints[index++];
+    while (true) {
+        // Apply constraints until one fails, a disjunction needs a choice, or
+        // all constraints are satisfied.
+        bool failed = false;
+        for (; index < constraints.size(); ++index) {
+            Constraint *constraint = constraints[index];
 
             // Skip disabled constraints
             if (constraint->isDisabled())
                 continue;
 
+            if (constraint->getKind() == ConstraintKind::Disjunction) {
+                ChoicePoint &choice = choicePoints.emplace_back(
+                    ChoicePoint { index, 0, state.checkpoint(), false, false }
+                );
+                // Only try the overloads that may accept the arguments bound
+                // so far. If there are none, every overload is tried so that
+                // the failure is diagnosed as usual.
+                bool filtered = getOverloadCandidates(
+                    constraint, state, choice.candidates
+                );
+                choice.onlyCandidates = filtered && !choice.candidates.empty();
+                updatePeak(_peakWorklist, depth + choicePoints.size());
+                break;
+            }
+
             /// Apply the constraint and check the result.
-            std::vector<SystemState> newStates;
-            ConstraintResult result = apply(constraint, current, newStates);
-            for (auto &newState : newStates) {
-                worklist.push_back({ std::move(newState), index });
+            std::vector<SystemState> nestedStates;
+            ConstraintResult status = apply(constraint, state, nestedStates);
+            markConstraint(status, constraint);
+            // Disjunctions nested in other constraints produce full states
+            for (auto &nestedState : nestedStates) {
+                if (!countExploredState())
+                    return;
+                exploreFrom(
+                    result, nestedState, index + 1, constraints,
+                    depth + choicePoints.size()
+                );
             }
-            markConstraint(result, constraint);
-            if (result == ConstraintResult::Failed) {
-                goto failed;
+            if (status == ConstraintResult::Failed) {
+                failed = true;
+                break;
+            }
+            // Branch and bound: prune states already worse than the best
+            // solution. Equally good states are kept to detect ambiguity.
+            if (!result.canImprove(state)) {
+                failed = true;
+                break;
             }
             // Continue if Satisfied or Applied
         }
 
-        /// All constraints are satisfied -- record the solution.
-        result.tryAddSolution(current);
+        if (!failed && index == constraints.size()) {
+            /// All constraints are satisfied -- record the solution.
+            result.tryAddSolution(state);
+        }
 
-    failed:
-        continue;
+        // Backtrack to the most recent disjunction with a viable branch left.
+        bool resumed = false;
+        while (!resumed && !choicePoints.empty()) {
+            ChoicePoint &choice = choicePoints.back();
+            Constraint *disjunction = constraints[choice.index];
+            auto branches = disjunction->getNestedConstraints();
+            state.rollback(choice.checkpoint);
+            if (choice.nextBranch == branches.size()) {
+                markConstraint(
+                    choice.anyViable ? ConstraintResult::Applied
+                                     : ConstraintResult::Failed,
+                    disjunction
+                );
+                choicePoints.pop_back();
+                continue;
+            }
+            Constraint *branch = branches[choice.nextBranch++];
+            if (!choice.admits(branch))
+                continue;
+            if (!countExploredState())
+                return;
+            std::vector<SystemState> nestedStates;
+            ConstraintResult status = apply(branch, state, nestedStates);
+            size_t nextIndex = choice.index + 1;
+            for (auto &nestedState : nestedStates) {
+                if (!countExploredState())
+                    return;
+                exploreFrom(
+                    result, nestedState, nextIndex, constraints,
+                    depth + choicePoints.size()
+                );
+            }
+            if (status == ConstraintResult::Satisfied) {
+                if (choice.anySatisfied) {
+                    continue;
+                }
+                choice.anySatisfied = true;
+            }
+            if (status != ConstraintResult::Failed) {
+                choice.anyViable = true;
+                // A pruned branch is viable but cannot beat the best solution
+                if (result.canImprove(state)) {
+                    index = nextIndex;
+                    resumed = true;
+                }
+            }
+        }
+        if (!resumed) {
+            return;
+        }
     }
+}
 
+bool ConstraintSystem::checkLocalSolution(
+    SolutionResult &result, llvm::ArrayRef<Constraint *> constraints
+)
+{
     if (result.isAmbiguous()) {
         reportAmbiguousSolutionError(result);
         return false;
@@ -194,72 +357,142 @@ bool ConstraintSystem::solveLocalConstraints(
     Solution *solution = result.getBestSolution();
 
     if (!solution) {
-        reportNoSolutionError();
+        reportNoSolutionError(constraints);
         return false;
     }
     return true;
 }
 
+std::vector<llvm::SmallVector<Constraint *, 8>>
+ConstraintSystem::partitionConstraints()
+{
+    // Union-find over constraint indices: two constraints end up in the same
+    // component if they (transitively) share a type variable.
+    std::vector<size_t> parent(_constraints.size());
+    for (size_t i = 0; i < parent.size(); ++i) {
+        parent[i] = i;
+    }
+    auto find = [&parent](size_t i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]]; // path halving
+            i = parent[i];
+        }
+        return i;
+    };
+
+    // The first constraint that mentioned each type variable
+    llvm::DenseMap<glu::types::TypeVariableTy *, size_t> owners;
+    llvm::DenseSet<glu::types::TypeVariableTy *> typeVars;
+    for (size_t i = 0; i < _constraints.size(); ++i) {
+        typeVars.clear();
+        collectTypeVariables(_constraints[i], typeVars);
+        for (auto *typeVar : typeVars) {
+            auto [it, inserted] = owners.try_emplace(typeVar, i);
+            if (inserted) {
+                continue;
+            }
+            size_t a = find(i), b = find(it->second);
+            if (a != b) {
+                // Keep the smallest index as the root, so that components
+                // are ordered by their first constraint
+                parent[std::max(a, b)] = std::min(a, b);
+            }
+        }
+    }
+
+    // Components keep the priority order of _constraints
+    std::vector<llvm::SmallVector<Constraint *, 8>> components;
+    llvm::DenseMap<size_t, size_t> componentIndices;
+    for (size_t i = 0; i < _constraints.size(); ++i) {
+        auto [it, inserted]
+            = componentIndices.try_emplace(find(i), components.size());
+        if (inserted) {
+            components.emplace_back();
+        }
+        components[it->second].push_back(_constraints[i]);
+    }
+    return components;
+}
+
+/// @brief Whether a component is worth solving on another thread. Only
+/// disjunctions make the search branch; other components are solved in a
+/// single linear pass, which is cheaper than scheduling a task.
+static bool isExpensiveComponent(llvm::ArrayRef<Constraint *> component)
+{
+    return llvm::any_of(component, [](Constraint *constraint) {
+        return constraint->getKind() == ConstraintKind::Disjunction;
+    });
+}
+
 bool ConstraintSystem::solveConstraints()
 {
+    auto start = std::chrono::steady_clock::now();
+    size_t constraintCount = _constraints.size();
+    size_t componentCount = 0;
+    auto recordStatistics = llvm::make_scope_exit([&] {
+        if (!_stats)
+            return;
+        _stats->addRecord(
+            { _root->getLocation(), constraintCount, componentCount,
+              _exploredStates, _peakWorklist,
+              std::chrono::steady_clock::now() - start }
+        );
+    });
+
     // Simplify constraints before solving and get initial state with early
     // bindings
     SystemState initialState = simplifyConstraints();
 
-    // color the constraints based on which type variables they contain
-    // map of color => set of used type variables
-    std::vector<llvm::DenseSet<glu::types::TypeVariableTy *>> colors;
-    // map of color => set of constraints
-    std::vector<llvm::DenseSet<Constraint *>> colorConstraints;
-    for (auto *constraint : _constraints) {
-        llvm::DenseSet<glu::types::TypeVariableTy *> typeVars;
-        collectTypeVariables(constraint, typeVars);
-        colors.push_back(std::move(typeVars));
-        colorConstraints.push_back({ constraint });
-    }
-    // merge colors that share type variables
-    bool changed;
-    do {
-        changed = false;
-        for (std::size_t i = 0; i < colors.size(); ++i) {
-            for (std::size_t j = i + 1; j < colors.size(); ++j) {
-                llvm::DenseSet<glu::types::TypeVariableTy *> intersection;
-                for (auto *typeVar : colors[j]) {
-                    if (colors[i].count(typeVar)) {
-                        intersection.insert(typeVar);
-                    }
-                }
-                if (!intersection.empty()) {
-                    // merge j into i
-                    for (auto *typeVar : colors[j]) {
-                        colors[i].insert(typeVar);
-                    }
-                    for (auto *constraint : colorConstraints[j]) {
-                        colorConstraints[i].insert(constraint);
-                    }
-                    changed = true;
-                    // Erase the merged color
-                    colors.erase(colors.begin() + j);
-                    colorConstraints.erase(colorConstraints.begin() + j);
-                    --j;
-                }
+    auto components = partitionConstraints();
+    componentCount = components.size();
+    std::vector<SolutionResult> results(components.size());
+
+    // Components are independent: the expensive ones are explored
+    // concurrently (they only share the thread-safe types arena), then the
+    // results are checked and merged in component order, so diagnostics and
+    // the final solution do not depend on scheduling.
+    size_t expensiveCount = llvm::count_if(components, [](auto &component) {
+        return isExpensiveComponent(component);
+    });
+    if (_threadPool && expensiveCount > 1) {
+        llvm::ThreadPoolTaskGroup group(*_threadPool);
+        for (size_t i = 0; i < components.size(); ++i) {
+            if (isExpensiveComponent(components[i])) {
+                group.async([this, &results, &components, &initialState, i] {
+                    auto scratchTypes = useScratchTypes();
+                    exploreLocalConstraints(
+                        results[i], initialState, components[i]
+                    );
+                });
+            }
+        }
+        for (size_t i = 0; i < components.size(); ++i) {
+            if (!isExpensiveComponent(components[i])) {
+                exploreLocalConstraints(
+                    results[i], initialState, components[i]
+                );
             }
         }
-    } while (changed);
-    // solve each color separately
+        group.wait();
+    } else {
+        for (size_t i = 0; i < components.size(); ++i) {
+            exploreLocalConstraints(results[i], initialState, components[i]);
+        }
+    }
+
+    if (hasExceededBudget()) {
+        reportTooComplexError();
+        return false;
+    }
+
     // Start with the initial state from simplification
     SystemState finalSolution = initialState;
 
-    for (std::size_t i = 0; i < colors.size(); ++i) {
-        // Disable all constraints not in this color
-        for (auto *constraint : _constraints) {
-            constraint->setEnabled(colorConstraints[i].count(constraint));
-        }
-        SolutionResult result;
-        if (!solveLocalConstraints(result, initialState)) {
+    for (size_t i = 0; i < components.size(); ++i) {
+        if (!checkLocalSolution(results[i], components[i])) {
             return false;
         }
-        result.getBestSolution()->mergeInto(finalSolution);
+        results[i].getBestSolution()->mergeInto(finalSolution);
     }
 
     mapTypeVariables(&finalSolution);
@@ -286,8 +519,8 @@ ConstraintSystem::applyBind(Constraint *constraint, SystemState &state)
     auto *second = constraint->getSecondType();
 
     // Check if constraint is already satisfied
-    auto *substitutedFirst = substitute(first, state.typeBindings, _context);
-    auto *substitutedSecond = substitute(second, state.typeBindings, _context);
+    auto *substitutedFirst = state.substitute(first);
+    auto *substitutedSecond = state.substitute(second);
     if (substitutedFirst == substitutedSecond) {
         return ConstraintResult::Satisfied;
     }
@@ -307,11 +540,11 @@ ConstraintSystem::applyDefaultable(Constraint *constraint, SystemState &state)
     auto *second = constraint->getSecondType();
 
     // Check if constraint is already satisfied
-    auto *substitutedFirst = substitute(first, state.typeBindings, _context);
-    auto *substitutedSecond = substitute(second, state.typeBindings, _context);
+    auto *substitutedFirst = state.substitute(first);
+    auto *substitutedSecond = state.substitute(second);
 
     if (substitutedFirst == substitutedSecond) {
-        state.defaultableConstraintsSatisfied++;
+        state.addSatisfiedDefaultable();
         return ConstraintResult::Satisfied;
     }
 
@@ -328,7 +561,7 @@ ConstraintSystem::applyDefaultable(Constraint *constraint, SystemState &state)
 
     // Apply the default binding directly to the current state
     if (unify(first, second, state)) {
-        state.defaultableConstraintsSatisfied++;
+        state.addSatisfiedDefaultable();
         return ConstraintResult::Applied;
     }
 
@@ -343,8 +576,8 @@ ConstraintResult ConstraintSystem::applyBindToPointerType(
     auto *second = constraint->getSecondType();
 
     // Check if constraint is already satisfied
-    auto *substitutedFirst = substitute(first, state.typeBindings, _context);
-    auto *substitutedSecond = substitute(second, state.typeBindings, _context);
+    auto *substitutedFirst = state.substitute(first);
+    auto *substitutedSecond = state.substitute(second);
 
     // If second is already a pointer type, check if first matches its
     // element type
@@ -384,10 +617,8 @@ ConstraintResult ConstraintSystem::applyBindToArrayElement(
     auto *arrayType = constraint->getSecondType();
 
     // Check if constraint is already satisfied
-    auto *substitutedElement
-        = substitute(elementType, state.typeBindings, _context);
-    auto *substitutedArray
-        = substitute(arrayType, state.typeBindings, _context);
+    auto *substitutedElement = state.substitute(elementType);
+    auto *substitutedArray = state.substitute(arrayType);
 
     // If second is already a static array type, check if first matches its
     // element type
@@ -419,8 +650,8 @@ ConstraintSystem::applyConversion(Constraint *constraint, SystemState &state)
     auto *toType = constraint->getSecondType();
 
     // Apply substitutions
-    fromType = substitute(fromType, state.typeBindings, _context);
-    toType = substitute(toType, state.typeBindings, _context);
+    fromType = state.substitute(fromType);
+    toType = state.substitute(toType);
 
     // Check if already the same type (trivial conversion)
     if (fromType == toType) {
@@ -440,8 +671,8 @@ ConstraintSystem::applyConversion(Constraint *constraint, SystemState &state)
     // Use the conversion visitor for systematic conversion checking
     if (isValidConversion(fromType, toType, state, false)) {
         // Substitute again
-        fromType = substitute(fromType, state.typeBindings, _context);
-        toType = substitute(toType, state.typeBindings, _context);
+        fromType = state.substitute(fromType);
+        toType = state.substitute(toType);
         // Record the implicit conversion if the locator is an expression
         if (fromType == toType) {
             return ConstraintResult::Applied; // No conversion needed,
@@ -450,7 +681,7 @@ ConstraintSystem::applyConversion(Constraint *constraint, SystemState &state)
         }
         if (auto *expr
             = llvm::dyn_cast<glu::ast::ExprBase>(constraint->getLocator())) {
-            state.implicitConversions[expr] = toType;
+            state.setImplicitConversion(expr, toType);
         }
         return ConstraintResult::Applied;
     }
@@ -465,8 +696,8 @@ ConstraintSystem::applyCheckedCast(Constraint *constraint, SystemState &state)
     auto *toType = constraint->getSecondType();
 
     // Apply substitutions
-    fromType = substitute(fromType, state.typeBindings, _context);
-    toType = substitute(toType, state.typeBindings, _context);
+    fromType = state.substitute(fromType);
+    toType = state.substitute(toType);
 
     // Check if already the same type
     if (fromType == toType) {
@@ -489,7 +720,7 @@ ConstraintSystem::applyBindOverload(Constraint *constraint, SystemState &state)
     auto *choice = constraint->getOverloadChoice();
 
     // Apply substitution to the type
-    nodeTy = substitute(nodeTy, state.typeBindings, _context);
+    nodeTy = state.substitute(nodeTy);
 
     // Get the function type from the chosen overload
     types::Ty functionTy = choice->getType();
@@ -527,7 +758,7 @@ ConstraintSystem::applyBindOverload(Constraint *constraint, SystemState &state)
         // Record the overload choice in the state
         if (auto *refExpr
             = llvm::dyn_cast<glu::ast::RefExpr>(constraint->getLocator())) {
-            state.overloadChoices[refExpr] = choice;
+            state.setOverloadChoice(refExpr, choice);
             return ConstraintResult::Applied;
         }
     }
@@ -583,8 +814,8 @@ ConstraintSystem::applyValueMember(Constraint *constraint, SystemState &state)
     auto *memberExpr = constraint->getMember();
 
     // Apply substitutions
-    baseType = substitute(baseType, state.typeBindings, _context);
-    memberType = substitute(memberType, state.typeBindings, _context);
+    baseType = state.substitute(baseType);
+    memberType = state.substitute(memberType);
 
     // The base type should be a struct type
     auto *structType = llvm::dyn_cast<glu::types::StructTy>(baseType);
@@ -710,8 +941,7 @@ ConstraintResult ConstraintSystem::applyExpressibleByIntLiteral(
     Constraint *constraint, SystemState &state
 )
 {
-    auto type
-        = substitute(constraint->getSingleType(), state.typeBindings, _context);
+    auto type = state.substitute(constraint->getSingleType());
 
     // Check if the expression type is an integer literal
     if (llvm::isa<glu::types::IntTy, glu::types::FloatTy>(type)) {
@@ -725,8 +955,7 @@ ConstraintResult ConstraintSystem::applyExpressibleByFloatLiteral(
     Constraint *constraint, SystemState &state
 )
 {
-    auto type
-        = substitute(constraint->getSingleType(), state.typeBindings, _context);
+    auto type = state.substitute(constraint->getSingleType());
 
     // Check if the expression type is a float literal
     if (llvm::isa<glu::types::FloatTy>(type)) {
@@ -740,8 +969,7 @@ ConstraintResult ConstraintSystem::applyExpressibleByStringLiteral(
     Constraint *constraint, SystemState &state
 )
 {
-    auto type
-        = substitute(constraint->getSingleType(), state.typeBindings, _context);
+    auto type = state.substitute(constraint->getSingleType());
 
     // Check if the expression type is a pointer
     if (auto exprType = llvm::dyn_cast<glu::types::PointerTy>(type)) {
@@ -768,8 +996,7 @@ ConstraintResult ConstraintSystem::applyExpressibleByBoolLiteral(
     Constraint *constraint, SystemState &state
 )
 {
-    auto type
-        = substitute(constraint->getSingleType(), state.typeBindings, _context);
+    auto type = state.substitute(constraint->getSingleType());
 
     // Check if the expression type is a boolean literal
     if (llvm::isa<glu::types::BoolTy>(type)) {
@@ -783,8 +1010,7 @@ ConstraintResult ConstraintSystem::applyStructInitialiser(
     Constraint *constraint, SystemState &state
 )
 {
-    auto *type
-        = substitute(constraint->getSingleType(), state.typeBindings, _context);
+    auto *type = state.substitute(constraint->getSingleType());
     auto *node
         = llvm::cast<ast::StructInitializerExpr>(constraint->getLocator());
 
@@ -795,7 +1021,7 @@ ConstraintResult ConstraintSystem::applyStructInitialiser(
             // Substitute template parameters with concrete types first,
             // then apply type variable substitutions
             auto *fieldType = structType->getSubstitutedFieldType(i);
-            fieldType = substitute(fieldType, state.typeBindings, _context);
+            fieldType = state.substitute(fieldType);
             if (!unify(fieldType, initialisers[i]->getType(), state)) {
                 return ConstraintResult::Failed;
             }
@@ -809,9 +1035,7 @@ ConstraintResult ConstraintSystem::applyStructInitialiser(
               || (arrayType->getSize() > 0 && elements.size() == 1))) {
             return ConstraintResult::Failed;
         }
-        auto elementType = substitute(
-            arrayType->getDataType(), state.typeBindings, _context
-        );
+        auto elementType = state.substitute(arrayType->getDataType());
         for (auto *element : elements) {
             if (!unify(elementType, element->getType(), state)) {
                 return ConstraintResult::Failed;
@@ -874,7 +1098,25 @@ void ConstraintSystem::reportAmbiguousSolutionError(
     }
 }
 
-void ConstraintSystem::reportNoSolutionError()
+void ConstraintSystem::reportTooComplexError()
+{
+    auto location = _root->getLocation();
+    _diagManager.error(
+        location,
+        "Expression is too complex to be solved in reasonable time "
+        "(exceeded the limit of "
+            + llvm::Twine(_stateBudget) + " explored states)"
+    );
+    _diagManager.note(
+        location,
+        "Try adding explicit type annotations or breaking it up into smaller "
+        "expressions"
+    );
+}
+
+void ConstraintSystem::reportNoSolutionError(
+    llvm::ArrayRef<Constraint *> constraints
+)
 {
     auto defaultLocation = _scopeTable->getNode()->getLocation();
 
@@ -883,7 +1125,7 @@ void ConstraintSystem::reportNoSolutionError()
     ast::TypePrinter printer;
     bool foundSpecificError = false;
 
-    for (auto *constraint : _constraints) {
+    for (auto *constraint : constraints) {
         if (constraint->isDisabled() || constraint->hasSucceeded()
             || !constraint->hasFailed())
             continue;
@@ -0,0 +1,325 @@
+#include "ConstraintSystem.hpp"
+#include "Sema.hpp"
+
+#include <array>
+
+namespace glu::sema {
+
+/// @brief Types statements whose expressions are fully determined locally,
+/// without generating any constraint.
+///
+/// A statement is accepted only when the constraint system would find a
+/// single solution without implicit conversions: literals take their
+/// contextual or default type, references name a single variable of a known
+/// type, and each operator has exactly one overload whose parameters match
+/// its operands exactly. Any other solution needs at least one conversion and
+/// would rank worse, so both paths agree. Everything else is left to the
+/// constraint system.
+///
+/// Results are only applied once the whole statement has been typed, so a
+/// statement handed to the constraint system is left untouched.
+class FastPathTyper {
+    ScopeTable *_scope;
+    glu::ast::ASTContext *_context;
+
+    /// @brief The types inferred for each expression.
+    llvm::SmallVector<
+        std::pair<glu::ast::ExprBase *, glu::types::TypeBase *>, 8>
+        _types;
+    /// @brief The declarations resolved for each reference.
+    llvm::SmallVector<
+        std::pair<glu::ast::RefExpr *, glu::ast::RefExpr::ReferencedVarDecl>, 4>
+        _references;
+    /// @brief The declaration whose type is inferred from its value, if any.
+    glu::ast::VarLetDecl *_inferredDecl = nullptr;
+    glu::types::TypeBase *_inferredDeclType = nullptr;
+
+public:
+    FastPathTyper(ScopeTable *scope, glu::ast::ASTContext *context)
+        : _scope(scope), _context(context)
+    {
+    }
+
+    /// @brief Types a statement or declaration if it is trivially typed.
+    /// @return True if the node was typed, false if it needs the constraint
+    /// system.
+    bool typeNode(glu::ast::ASTNode *node)
+    {
+        if (!typeStatement(node))
+            return false;
+
+        for (auto [expr, type] : _types)
+            expr->setType(type);
+        for (auto [ref, decl] : _references)
+            ref->setVariable(decl);
+        if (_inferredDecl)
+            _inferredDecl->setType(_inferredDeclType);
+        return true;
+    }
+
+private:
+    bool typeStatement(glu::ast::ASTNode *node)
+    {
+        if (auto *declStmt = llvm::dyn_cast<glu::ast::DeclStmt>(node))
+            node = declStmt->getDecl();
+
+        if (auto *varLet = llvm::dyn_cast<glu::ast::VarLetDecl>(node))
+            return typeVarLetDecl(varLet);
+
+        if (auto *assign = llvm::dyn_cast<glu::ast::AssignStmt>(node)) {
+            auto *leftType = inferExpr(assign->getExprLeft(), nullptr);
+            return leftType
+                && inferExpr(assign->getExprRight(), leftType) != nullptr;
+        }
+
+        if (auto *ret = llvm::dyn_cast<glu::ast::ReturnStmt>(node))
+            return typeReturnStmt(ret);
+
+        if (auto *exprStmt = llvm::dyn_cast<glu::ast::ExpressionStmt>(node))
+            return inferExpr(exprStmt->getExpr(), nullptr) != nullptr;
+
+        auto *boolType = _context->getBoolType();
+        if (auto *ifStmt = llvm::dyn_cast<glu::ast::IfStmt>(node))
+            return inferExpr(ifStmt->getCondition(), boolType) != nullptr;
+        if (auto *whileStmt = llvm::dyn_cast<glu::ast::WhileStmt>(node))
+            return inferExpr(whileStmt->getCondition(), boolType) != nullptr;
+
+        // Nothing to type
+        return llvm::isa<glu::ast::BreakStmt, glu::ast::ContinueStmt>(node);
+    }
+
+    bool typeVarLetDecl(glu::ast::VarLetDecl *varLet)
+    {
+        auto *type = varLet->getType();
+        auto *value = varLet->getValue();
+
+        if (type && !isResolvedType(type))
+            return false;
+        if (!value)
+            return type != nullptr;
+
+        auto *valueType = inferExpr(value, type);
+        if (!valueType)
+            return false;
+        if (!type) {
+            _inferredDecl = varLet;
+            _inferredDeclType = valueType;
+        }
+        return true;
+    }
+
+    bool typeReturnStmt(glu::ast::ReturnStmt *node)
+    {
+        auto *function = _scope->getFunctionDecl();
+        if (!function)
+            return false;
+
+        auto *expectedType = function->getType()->getReturnType();
+        bool returnsVoid = llvm::isa<glu::types::VoidTy>(expectedType);
+
+        // Mismatches are diagnosed by the constraint system
+        if (!node->getReturnExpr())
+            return returnsVoid;
+        if (returnsVoid || !isResolvedType(expectedType))
+            return false;
+        return inferExpr(node->getReturnExpr(), expectedType) != nullptr;
+    }
+
+    /// @brief Infers the type of an expression.
+    /// @param expr The expression to type.
+    /// @param expectedType The type the expression must have exactly, or null
+    /// if it is free.
+    /// @return The type of the expression, or null if it needs the constraint
+    /// system.
+    glu::types::TypeBase *
+    inferExpr(glu::ast::ExprBase *expr, glu::types::TypeBase *expectedType)
+    {
+        // Already typed, e.g. by the parser: leave it to the solver
+        if (expr->getType())
+            return nullptr;
+
+        glu::types::TypeBase *type = nullptr;
+        if (auto *literal = llvm::dyn_cast<glu::ast::LiteralExpr>(expr)) {
+            type = inferLiteral(literal, expectedType);
+        } else if (auto *ref = llvm::dyn_cast<glu::ast::RefExpr>(expr)) {
+            type = inferVariableRef(ref);
+        } else if (auto *binaryOp
+                   = llvm::dyn_cast<glu::ast::BinaryOpExpr>(expr)) {
+            type = inferBinaryOp(binaryOp, expectedType);
+        }
+
+        if (!type || (expectedType && type != expectedType))
+            return nullptr;
+        _types.push_back({ expr, type });
+        return type;
+    }
+
+    glu::types::TypeBase *inferLiteral(
+        glu::ast::LiteralExpr *literal, glu::types::TypeBase *expectedType
+    )
+    {
+        if (expectedType)
+            return isExpressibleBy(literal, expectedType) ? expectedType
+                                                          : nullptr;
+
+        return std::visit(
+            [&](auto &&value) -> glu::types::TypeBase * {
+                using T = std::decay_t<decltype(value)>;
+
+                if constexpr (std::is_same_v<T, llvm::APInt>) {
+                    return _context->getIntType(glu::types::IntTy::Signed, 32);
+                } else if constexpr (std::is_same_v<T, llvm::APFloat>) {
+                    return _context->getFloatType(glu::types::FloatTy::DOUBLE);
+                } else if constexpr (std::is_same_v<T, bool>) {
+                    return _context->getBoolType();
+                } else {
+                    // Strings and null convert to several types
+                    return nullptr;
+                }
+            },
+            literal->getValue()
+        );
+    }
+
+    /// @brief Whether a literal can take a type without conversion, with the
+    /// same rules as the ExpressibleBy*Literal constraints.
+    static bool
+    isExpressibleBy(glu::ast::LiteralExpr *literal, glu::types::TypeBase *type)
+    {
+        return std::visit(
+            [type](auto &&value) {
+                using T = std::decay_t<decltype(value)>;
+
+                if constexpr (std::is_same_v<T, llvm::APInt>) {
+                    return llvm::isa<glu::types::IntTy, glu::types::FloatTy>(
+                        type
+                    );
+                } else if constexpr (std::is_same_v<T, llvm::APFloat>) {
+                    return llvm::isa<glu::types::FloatTy>(type);
+                } else if constexpr (std::is_same_v<T, bool>) {
+                    return llvm::isa<glu::types::BoolTy>(type);
+                } else {
+                    return false;
+                }
+            },
+            literal->getValue()
+        );
+    }
+
+    glu::types::TypeBase *inferVariableRef(glu::ast::RefExpr *ref)
+    {
+        auto *item = _scope->lookupItem(ref->getIdentifiers());
+        if (!item || item->decls.size() != 1)
+            return nullptr;
+
+        auto *varDecl = llvm::dyn_cast<glu::ast::VarLetDecl>(
+            item->decls.front().item
+        );
+        if (!varDecl || !varDecl->getType()
+            || !isResolvedType(varDecl->getType()))
+            return nullptr;
+
+        _references.push_back({ ref, varDecl });
+        return varDecl->getType();
+    }
+
+    glu::types::TypeBase *inferBinaryOp(
+        glu::ast::BinaryOpExpr *node, glu::types::TypeBase *expectedType
+    )
+    {
+        auto *op = node->getOperator();
+        if (op->getType())
+            return nullptr;
+
+        // These operators have built-in meanings besides their overloads
+        auto name = op->getIdentifier();
+        if (name == "&&" || name == "||" || name == "[")
+            return nullptr;
+
+        // Literal operands take the type of the chosen overload's parameter,
+        // every other operand has a type of its own.
+        std::array<glu::ast::ExprBase *, 2> operands
+            = { node->getLeftOperand(), node->getRightOperand() };
+        std::array<glu::types::TypeBase *, 2> operandTypes = { nullptr,
+                                                               nullptr };
+        for (size_t i = 0; i < operands.size(); ++i) {
+            if (llvm::isa<glu::ast::LiteralExpr>(operands[i]))
+                continue;
+            operandTypes[i] = inferExpr(operands[i], nullptr);
+            if (!operandTypes[i])
+                return nullptr;
+        }
+
+        auto *item = _scope->lookupItem(op->getIdentifiers());
+        if (!item)
+            return nullptr;
+
+        glu::ast::FunctionDecl *match = nullptr;
+        for (auto &decl : item->decls) {
+            auto *fnDecl = llvm::dyn_cast<glu::ast::FunctionDecl>(decl.item);
+            if (!fnDecl || fnDecl->getTemplateParams()
+                || !isResolvedType(fnDecl->getType()))
+                return nullptr;
+
+            auto *fnTy = fnDecl->getType();
+            if (fnTy->isCVariadic() || fnTy->getRequiredParameterCount() > 2)
+                continue;
+            // Default parameters would need the full arity rules
+            if (fnTy->getParameterCount() != 2) {
+                if (fnTy->getParameterCount() > 2)
+                    return nullptr;
+                continue;
+            }
+
+            bool exact = true;
+            for (size_t i = 0; i < operands.size() && exact; ++i) {
+                auto *paramTy = fnTy->getParameter(i);
+                auto *literal
+                    = llvm::dyn_cast<glu::ast::LiteralExpr>(operands[i]);
+                exact = literal ? isExpressibleBy(literal, paramTy)
+                                : operandTypes[i] == paramTy;
+            }
+            if (!exact
+                || (expectedType && fnTy->getReturnType() != expectedType))
+                continue;
+
+            // Several overloads fit exactly, only ranking can choose
+            if (match)
+                return nullptr;
+            match = fnDecl;
+        }
+        if (!match)
+            return nullptr;
+
+        auto *fnTy = match->getType();
+        for (size_t i = 0; i < operands.size(); ++i) {
+            if (!operandTypes[i]
+                && !inferExpr(operands[i], fnTy->getParameter(i)))
+                return nullptr;
+        }
+
+        _types.push_back({ op, fnTy });
+        _references.push_back({ op, match });
+        return fnTy->getReturnType();
+    }
+
+    /// @brief Whether the constraint system would use a type as is: it has
+    /// no type variable to infer and no alias to look through.
+    bool isResolvedType(glu::types::TypeBase *type) const
+    {
+        static llvm::DenseMap<
+            glu::types::TypeVariableTy *, glu::types::TypeBase *> const
+            noBindings;
+        return !containsTypeVariable(type)
+            && substitute(type, noBindings, _context) == type;
+    }
+};
+
+bool tryFastPathTyping(
+    ScopeTable *scope, ast::ASTNode *node, glu::ast::ASTContext *context
+)
+{
+    return FastPathTyper(scope, context).typeNode(node);
+}
+
+} // namespace glu::sema
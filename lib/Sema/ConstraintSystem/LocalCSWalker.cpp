@@ -8,8 +8,11 @@ namespace glu::sema {
 
 /// @brief Walks the AST to generate and solve constraints for expressions
 /// within a statement.
-class LocalCSWalker : public glu::ast::ASTWalker<LocalCSWalker, void> {
+class LocalCSWalker : public glu::ast::IterativeASTWalker<LocalCSWalker> {
     ConstraintSystem _cs;
+    /// @brief Keeps the type variables and the types made from them out of
+    /// the permanent arena while the system is built and solved.
+    ConstraintSystem::ScratchTypesScope _scratchTypes;
     glu::DiagnosticManager &_diagManager;
     glu::ast::ASTContext *_astContext;
 
@@ -19,14 +22,17 @@ class LocalCSWalker : public glu::ast::ASTWalker<LocalCSWalker, void> {
 public:
     LocalCSWalker(
         ScopeTable *scope, glu::DiagnosticManager &diagManager,
-        glu::ast::ASTContext *context,
-        llvm::raw_ostream *dumpConstraints = nullptr
+        glu::ast::ASTContext *context, SolverOptions const &options = {}
     )
         : _cs(scope, diagManager, context)
+        , _scratchTypes(_cs.useScratchTypes())
         , _diagManager(diagManager)
         , _astContext(context)
-        , _dumpConstraints(dumpConstraints)
+        , _dumpConstraints(options.dumpConstraints ? &llvm::outs() : nullptr)
     {
+        _cs.setStatistics(options.stats);
+        _cs.setStateBudget(options.stateBudget);
+        _cs.setThreadPool(options.threadPool);
     }
 
     ~LocalCSWalker()
@@ -93,8 +99,6 @@ public:
     /// @brief Visits a literal expression and generates type constraints.
     void postVisitLiteralExpr(glu::ast::LiteralExpr *node)
     {
-        auto &memoryArena
-            = node->getModule()->getContext()->getTypesMemoryArena();
         auto value = node->getValue();
 
         // Get the current type of the literal expression
@@ -111,25 +115,25 @@ public:
 
                 if constexpr (std::is_same_v<T, llvm::APInt>) {
                     // Integer literal - default to signed 32-bit integer
-                    defaultType = memoryArena.create<glu::types::IntTy>(
-                        glu::types::IntTy(glu::types::IntTy::Signed, 32)
+                    defaultType = _astContext->getIntType(
+                        glu::types::IntTy::Signed, 32
                     );
                 } else if constexpr (std::is_same_v<T, llvm::APFloat>) {
                     // Float literal - default to 64-bit double
-                    defaultType = memoryArena.create<glu::types::FloatTy>(
-                        glu::types::FloatTy(glu::types::FloatTy::DOUBLE)
+                    defaultType = _astContext->getFloatType(
+                        glu::types::FloatTy::DOUBLE
                     );
                     kind = ConstraintKind::ExpressibleByFloatLiteral;
                 } else if constexpr (std::is_same_v<T, bool>) {
                     // Boolean literal
-                    defaultType = memoryArena.create<glu::types::BoolTy>();
+                    defaultType = _astContext->getBoolType();
                     kind = ConstraintKind::ExpressibleByBoolLiteral;
                 } else if constexpr (std::is_same_v<T, llvm::StringRef>) {
                     // String literal - create pointer to char type
                     defaultType = _cs.getScopeTable()->lookupType("String");
                     kind = ConstraintKind::ExpressibleByStringLiteral;
                 } else if constexpr (std::is_same_v<T, std::nullptr_t>) {
-                    defaultType = memoryArena.create<glu::types::NullTy>();
+                    defaultType = _astContext->getNullType();
                     _cs.addConstraint(
                         Constraint::createBind(
                             _cs.getAllocator(), nodeType, defaultType, node
@@ -186,10 +190,7 @@ public:
                 )
             );
         } else {
-            auto *returnType = node->getModule()
-                                   ->getContext()
-                                   ->getTypesMemoryArena()
-                                   .create<glu::types::VoidTy>();
+            auto *returnType = _astContext->getVoidType();
 
             _cs.addConstraint(
                 Constraint::createEqual(
@@ -205,9 +206,7 @@ public:
         auto *cond = node->getCondition();
         visit(cond);
         _cs.setRoot(cond);
-        auto &memoryArena
-            = cond->getModule()->getContext()->getTypesMemoryArena();
-        auto *boolType = memoryArena.create<glu::types::BoolTy>();
+        auto *boolType = _astContext->getBoolType();
         auto constraint
             = Constraint::createConversion(_cs.getAllocator(), cond, boolType);
         _cs.addConstraint(constraint);
@@ -220,9 +219,7 @@ public:
         auto *cond = node->getCondition();
         visit(cond);
         _cs.setRoot(cond);
-        auto &memoryArena
-            = cond->getModule()->getContext()->getTypesMemoryArena();
-        auto *boolType = memoryArena.create<glu::types::BoolTy>();
+        auto *boolType = _astContext->getBoolType();
         auto constraint
             = Constraint::createConversion(_cs.getAllocator(), cond, boolType);
         _cs.addConstraint(constraint);
@@ -296,7 +293,7 @@ public:
         constraints.push_back(createRangeAccessorRef(
             node, "==", &ast::ForStmt::setEqualityFunc,
             { iteratorType, iteratorType },
-            typesArena.create<glu::types::BoolTy>()
+            _astContext->getBoolType()
         ));
 
         return Constraint::createConjunction(
@@ -309,7 +306,6 @@ public:
     )
     {
         auto *binding = node->getBinding();
-        auto &typesArena = _astContext->getTypesMemoryArena();
         auto *token = _cs.getScopeTable()->lookupNamespace("std")->lookupType(
             "StaticArrayToken"
         );
@@ -317,7 +313,7 @@ public:
             token
             && "std::StaticArrayToken type must be defined for ForStmt use"
         );
-        auto *voidType = typesArena.create<glu::types::VoidTy>();
+        auto *voidType = _astContext->getVoidType();
 
         llvm::SmallVector<Constraint *, 5> constraints;
         constraints.push_back(
@@ -336,12 +332,10 @@ public:
             bindRangeAccessorRef(node->getDerefFunc(), { token }, voidType)
         );
 
-        auto *u64 = typesArena.create<glu::types::IntTy>(
-            glu::types::IntTy(glu::types::IntTy::Unsigned, 64)
-        );
+        auto *u64 = _astContext->getIntType(glu::types::IntTy::Unsigned, 64);
         constraints.push_back(bindRangeAccessorRef(
             node->getEqualityFunc(), { u64, u64 },
-            typesArena.create<glu::types::BoolTy>()
+            _astContext->getBoolType()
         ));
 
         constraints.push_back(
@@ -363,9 +357,7 @@ public:
         auto *falseType = node->getFalseExpr()->getType();
         auto *ternaryType = node->getType();
 
-        auto &memoryArena
-            = node->getModule()->getContext()->getTypesMemoryArena();
-        auto boolType = memoryArena.create<glu::types::BoolTy>();
+        auto *boolType = _astContext->getBoolType();
 
         _cs.addConstraint(
             Constraint::createConversion(
@@ -422,7 +414,7 @@ public:
         auto *operandTy = node->getOperand()->getType();
         auto *resultTy = node->getType();
 
-        auto &arena = node->getModule()->getContext()->getTypesMemoryArena();
+        auto &arena = _astContext->getTypesMemoryArena();
 
         auto *expectedFnTy = arena.create<glu::types::FunctionTy>(
             llvm::ArrayRef<glu::types::TypeBase *> { operandTy }, resultTy
@@ -462,8 +454,7 @@ public:
 
     void postVisitBinaryOpExpr(glu::ast::BinaryOpExpr *node)
     {
-        auto *typesArena
-            = &node->getModule()->getContext()->getTypesMemoryArena();
+        auto *typesArena = &_astContext->getTypesMemoryArena();
 
         auto *lhs = node->getLeftOperand();
         auto *rhs = node->getRightOperand();
@@ -643,13 +634,13 @@ private:
         types::FunctionTy *fnTy = nullptr;
 
         if (node->getIdentifier() == "&&" || node->getIdentifier() == "||") {
-            auto *boolTy = types.create<types::BoolTy>();
+            auto *boolTy = _astContext->getBoolType();
             fnTy = types.create<types::FunctionTy>(
                 llvm::ArrayRef<types::TypeBase *> { boolTy, boolTy }, boolTy
             );
         }
         if (node->getIdentifier() == "[") {
-            auto *u64 = types.create<types::IntTy>(types::IntTy::Unsigned, 64);
+            auto *u64 = _astContext->getIntType(types::IntTy::Unsigned, 64);
             auto *ptrTy = types.create<types::PointerTy>(parent->getType());
             fnTy = types.create<types::FunctionTy>(
                 llvm::ArrayRef<types::TypeBase *> { ptrTy, u64 },
@@ -697,10 +688,16 @@ private:
 
 void runLocalCSWalker(
     ScopeTable *scope, ast::ASTNode *node, glu::DiagnosticManager &diagManager,
-    glu::ast::ASTContext *context, llvm::raw_ostream *dumpConstraints
+    glu::ast::ASTContext *context, SolverOptions const &options
 )
 {
-    LocalCSWalker(scope, diagManager, context, dumpConstraints).visit(node);
+    // Constraint dumps should show every statement
+    if (!options.dumpConstraints && tryFastPathTyping(scope, node, context)) {
+        if (options.stats)
+            options.stats->recordFastPath();
+        return;
+    }
+    LocalCSWalker(scope, diagManager, context, options).visit(node);
 }
 
 } // namespace glu::sema
@@ -2,6 +2,61 @@
 
 namespace glu::sema {
 
+/// @brief Checks whether a type still contains unresolved type variables.
+class TypeVariableFinder
+    : public glu::types::TypeVisitor<TypeVariableFinder, bool> {
+public:
+    bool visitTypeBase([[maybe_unused]] glu::types::TypeBase *type)
+    {
+        return false;
+    }
+
+    bool visitTypeVariableTy([[maybe_unused]] glu::types::TypeVariableTy *type)
+    {
+        return true;
+    }
+
+    bool visitFunctionTy(glu::types::FunctionTy *type)
+    {
+        return visit(type->getReturnType())
+            || llvm::any_of(type->getParameters(), [this](auto *param) {
+                   return visit(param);
+               });
+    }
+
+    bool visitPointerTy(types::PointerTy *type)
+    {
+        return visit(type->getPointee());
+    }
+
+    bool visitTypeAliasTy(types::TypeAliasTy *type)
+    {
+        return visit(type->getWrappedType());
+    }
+
+    bool visitStaticArrayTy(types::StaticArrayTy *type)
+    {
+        return visit(type->getDataType());
+    }
+
+    bool visitDynamicArrayTy(types::DynamicArrayTy *type)
+    {
+        return visit(type->getDataType());
+    }
+
+    bool visitStructTy(types::StructTy *type)
+    {
+        return llvm::any_of(type->getTemplateArgs(), [this](auto *arg) {
+            return visit(arg);
+        });
+    }
+};
+
+bool containsTypeVariable(glu::types::TypeBase *type)
+{
+    return TypeVariableFinder().visit(type);
+}
+
 /// @brief Helper function to count conversions for function-like expressions
 /// (calls, operators)
 /// @param functionTy The function type of the operator/callee
@@ -56,8 +111,7 @@ size_t SystemState::getExprConversionCount(
     glu::ast::ExprBase *expr, types::TypeBase *targetType
 ) const
 {
-    auto *substitutedExprType
-        = substitute(expr->getType(), typeBindings, _context);
+    auto *substitutedExprType = substitute(expr->getType());
     if (substitutedExprType == targetType) {
         return 0; // No conversion needed
     }
@@ -68,8 +122,7 @@ size_t SystemState::getExprConversionCount(
     if (!refExpr)
         return 1;
 
-    auto *substitutedRefType
-        = substitute(refExpr->getType(), typeBindings, _context);
+    auto *substitutedRefType = substitute(refExpr->getType());
     auto *functionTy = llvm::dyn_cast<types::FunctionTy>(substitutedRefType);
     auto *concreteTy = llvm::dyn_cast<types::FunctionTy>(targetType);
     if (!functionTy || !concreteTy)
@@ -110,7 +163,7 @@ size_t SystemState::getImplicitConversionCount() const
     size_t count = 0;
     for (auto const &[expr, type] : implicitConversions) {
         // substitute the type to see if it's still needed
-        auto substitutedType = substitute(type, typeBindings, _context);
+        auto substitutedType = substitute(type);
         count += getExprConversionCount(expr, substitutedType);
     }
     return count;
@@ -133,33 +186,143 @@ std::weak_ordering SystemState::operator<=>(SystemState const &other) const
 
 void SolutionResult::tryAddSolution(SystemState const &s)
 {
+    // The score of the best solutions is cached, so only the new solution's
+    // conversions are substituted.
+    Score score = s.getImplicitConversionCount();
+
     // If no previous solutions exist just add directly
     if (solutions.empty()) {
-        solutions.push_back(std::move(s));
+        bestScore = score;
+        solutions.push_back(s.clone());
         return;
     }
 
-    auto comparison = s <=> solutions.front();
+    // less conversions is better, then more satisfied defaultable
+    // constraints is better
+    auto comparison = score <=> bestScore;
+    if (comparison == 0)
+        comparison = solutions.front().defaultableConstraintsSatisfied
+            <=> s.defaultableConstraintsSatisfied;
     if (comparison == std::weak_ordering::less) {
         // if there is a better solution then replace previous ones
         // (less is better here since it means fewer conversions)
         solutions.clear();
-        solutions.push_back(std::move(s));
+        bestScore = score;
+        solutions.push_back(s.clone());
     } else if (comparison == std::weak_ordering::equivalent) {
         // Ambiguity: multiple equally good solutions
-        solutions.push_back(std::move(s));
+        solutions.push_back(s.clone());
     } else {
         // Worse solution, ignore
         return;
     }
 }
 
+void SystemState::bindType(
+    glu::types::TypeVariableTy *var, glu::types::TypeBase *type
+)
+{
+    auto [it, inserted] = typeBindings.try_emplace(var, type);
+    trail.push_back({ TrailEntry::Kind::TypeBinding, var,
+                      inserted ? nullptr : it->second });
+    it->second = type;
+    bindingGeneration++;
+}
+
+void SystemState::setOverloadChoice(
+    glu::ast::RefExpr *expr, glu::ast::FunctionDecl *decl
+)
+{
+    auto [it, inserted] = overloadChoices.try_emplace(expr, decl);
+    trail.push_back({ TrailEntry::Kind::OverloadChoice, expr,
+                      inserted ? nullptr : it->second });
+    it->second = decl;
+}
+
+void SystemState::setImplicitConversion(
+    glu::ast::ExprBase *expr, glu::types::TypeBase *type
+)
+{
+    auto [it, inserted] = implicitConversions.try_emplace(expr, type);
+    trail.push_back({ TrailEntry::Kind::ImplicitConversion, expr,
+                      inserted ? nullptr : it->second });
+    it->second = type;
+
+    // A conversion of a plain expression between two types without type
+    // variables can no longer be made unnecessary by later bindings.
+    bool certain = !llvm::isa<ast::RefExpr>(expr)
+        && !containsTypeVariable(type)
+        && !containsTypeVariable(substitute(expr->getType()));
+    bool wasCertain = certainConversions.count(expr);
+    if (certain == wasCertain)
+        return;
+    trail.push_back({ TrailEntry::Kind::CertainConversion, expr,
+                      wasCertain ? expr : nullptr });
+    if (certain)
+        certainConversions.insert(expr);
+    else
+        certainConversions.erase(expr);
+}
+
+void SystemState::addSatisfiedDefaultable()
+{
+    defaultableConstraintsSatisfied++;
+    trail.push_back({ TrailEntry::Kind::Defaultable, nullptr, nullptr });
+}
+
+/// @brief Restores one map entry to its previous value, erasing it if it did
+/// not exist before.
+template <typename Map>
+static void restoreEntry(Map &map, void *key, void *previous)
+{
+    using Key = typename Map::key_type;
+    using Value = typename Map::mapped_type;
+    if (previous) {
+        map[static_cast<Key>(key)] = static_cast<Value>(previous);
+    } else {
+        map.erase(static_cast<Key>(key));
+    }
+}
+
+void SystemState::rollback(size_t checkpoint)
+{
+    assert(checkpoint <= trail.size() && "Invalid trail checkpoint");
+    while (trail.size() > checkpoint) {
+        TrailEntry entry = trail.back();
+        trail.pop_back();
+        switch (entry.kind) {
+        case TrailEntry::Kind::TypeBinding:
+            restoreEntry(typeBindings, entry.key, entry.previous);
+            bindingGeneration++;
+            break;
+        case TrailEntry::Kind::OverloadChoice:
+            restoreEntry(overloadChoices, entry.key, entry.previous);
+            break;
+        case TrailEntry::Kind::ImplicitConversion:
+            restoreEntry(implicitConversions, entry.key, entry.previous);
+            break;
+        case TrailEntry::Kind::CertainConversion: {
+            auto *expr = static_cast<ast::ExprBase *>(entry.key);
+            if (entry.previous)
+                certainConversions.insert(expr);
+            else
+                certainConversions.erase(expr);
+            break;
+        }
+        case TrailEntry::Kind::Defaultable:
+            defaultableConstraintsSatisfied--;
+            break;
+        }
+    }
+}
+
 void SystemState::mergeInto(SystemState &other) const
 {
     // Merge type bindings
     for (auto const &[var, type] : typeBindings) {
         other.typeBindings[var] = type;
     }
+    other.bindingGeneration++;
 
     // Merge overload choices
     for (auto const &[expr, decl] : overloadChoices) {
@@ -0,0 +1,66 @@
+#include "SolverStatistics.hpp"
+
+#include <llvm/Support/Format.h>
+
+#include <algorithm>
+
+namespace glu::sema {
+
+/// @brief Converts a duration to milliseconds for printing.
+static double toMilliseconds(std::chrono::nanoseconds time)
+{
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+void SolverStatistics::print(
+    llvm::raw_ostream &os, SourceManager const &sourceManager,
+    size_t slowestCount
+) const
+{
+    SolverRecord total;
+    for (auto const &record : _records) {
+        total.constraints += record.constraints;
+        total.components += record.components;
+        total.exploredStates += record.exploredStates;
+        total.peakWorklist = std::max(total.peakWorklist, record.peakWorklist);
+        total.time += record.time;
+    }
+
+    os << "=== Constraint solver statistics ===\n";
+    os << "Fast-path typed:    " << _fastPathCount << "\n";
+    os << "Constraint systems: " << _records.size() << "\n";
+    os << "Constraints:        " << total.constraints << "\n";
+    os << "Components:         " << total.components << "\n";
+    os << "States explored:    " << total.exploredStates << "\n";
+    os << "Peak worklist:      " << total.peakWorklist << "\n";
+    os << "Time:               "
+       << llvm::format("%.3f ms", toMilliseconds(total.time)) << "\n";
+
+    if (_records.empty())
+        return;
+
+    std::vector<SolverRecord const *> slowest;
+    for (auto const &record : _records)
+        slowest.push_back(&record);
+    size_t count = std::min(slowestCount, slowest.size());
+    std::partial_sort(
+        slowest.begin(), slowest.begin() + count, slowest.end(),
+        [](SolverRecord const *a, SolverRecord const *b) {
+            return a->time > b->time;
+        }
+    );
+
+    os << "Slowest expressions:\n";
+    for (size_t i = 0; i < count; ++i) {
+        auto const *record = slowest[i];
+        os << "  " << sourceManager.getBufferName(record->location) << ":"
+           << sourceManager.getSpellingLineNumber(record->location) << ":"
+           << sourceManager.getSpellingColumnNumber(record->location) << ": "
+           << llvm::format("%.3f ms", toMilliseconds(record->time)) << " ("
+           << record->constraints << " constraints, "
+           << record->exploredStates << " states, peak worklist "
+           << record->peakWorklist << ")\n";
+    }
+}
+
+} // namespace glu::sema
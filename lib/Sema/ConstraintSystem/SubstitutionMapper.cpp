@@ -11,6 +11,7 @@ namespace glu::sema {
 class SubstitutionMapper : public TypeMappingVisitorBase<SubstitutionMapper> {
     llvm::DenseMap<glu::types::TypeVariableTy *, glu::types::TypeBase *> const
         &_bindings;
+    bool _sawTypeVariable = false;
 
 public:
     SubstitutionMapper(
@@ -25,6 +26,7 @@ public:
 
     glu::types::TypeBase *visitTypeVariableTy(glu::types::TypeVariableTy *type)
     {
+        _sawTypeVariable = true;
         auto it = _bindings.find(type);
         if (it != _bindings.end()) {
             // Recursively substitute to handle chains like T1 -> T2 -> Int
@@ -37,8 +39,24 @@ public:
     {
         return visit(type->getWrappedType());
     }
+
+    /// @brief Whether a type variable was met, bound or not. Substitutions
+    /// of types without any do not depend on the bindings.
+    bool sawTypeVariable() const { return _sawTypeVariable; }
 };
 
+/// @brief Whether substituting a type may return another type. Other types
+/// have no type variable or alias to replace, and are returned as is.
+static bool isSubstitutable(glu::types::TypeBase *type)
+{
+    if (auto *structTy = llvm::dyn_cast<glu::types::StructTy>(type))
+        return !structTy->getTemplateArgs().empty();
+    return llvm::isa<
+        glu::types::TypeVariableTy, glu::types::TypeAliasTy,
+        glu::types::FunctionTy, glu::types::PointerTy,
+        glu::types::StaticArrayTy, glu::types::DynamicArrayTy>(type);
+}
+
 /// @brief Substitutes type variables with their bindings in a type.
 /// @param type The type to substitute.
 /// @param bindings The current type variable bindings.
@@ -55,4 +73,21 @@ glu::types::Ty substitute(
     return mapper.visit(type);
 }
 
+glu::types::Ty SystemState::substitute(glu::types::Ty type) const
+{
+    if (!isSubstitutable(type))
+        return type;
+
+    auto it = substitutionCache.find(type);
+    if (it != substitutionCache.end()
+        && (it->second.stable || it->second.generation == bindingGeneration))
+        return it->second.result;
+
+    SubstitutionMapper mapper(_context, typeBindings);
+    auto *result = mapper.visit(type);
+    substitutionCache[type]
+        = { result, bindingGeneration, !mapper.sawTypeVariable() };
+    return result;
+}
+
 } // namespace glu::sema
@@ -28,7 +28,7 @@ public:
 
     glu::types::TypeBase *visitTypeVariableTy(glu::types::TypeVariableTy *type)
     {
-        auto mapped = substitute(type, _solution->typeBindings, _context);
+        auto mapped = _solution->substitute(type);
         if (llvm::isa<glu::types::TypeVariableTy>(mapped)) {
             _diagManager.error(_location, "Unresolved type variable");
         }
@@ -97,8 +97,8 @@ bool ConstraintSystem::unify(
 )
 {
     // Apply substitutions
-    first = substitute(first, state.typeBindings, _context);
-    second = substitute(second, state.typeBindings, _context);
+    first = state.substitute(first);
+    second = state.substitute(second);
 
     if (first == second)
         return true;
@@ -107,14 +107,14 @@ bool ConstraintSystem::unify(
     if (auto *firstVar = llvm::dyn_cast<glu::types::TypeVariableTy>(first)) {
         if (occursCheck(firstVar, second, state.typeBindings))
             return false;
-        state.typeBindings[firstVar] = second;
+        state.bindType(firstVar, second);
         return true;
     }
 
     if (auto *secondVar = llvm::dyn_cast<glu::types::TypeVariableTy>(second)) {
         if (occursCheck(secondVar, first, state.typeBindings))
             return false;
-        state.typeBindings[secondVar] = first;
+        state.bindType(secondVar, first);
         return true;
     }
 
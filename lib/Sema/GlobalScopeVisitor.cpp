@@ -49,7 +49,10 @@ void registerBinaryBuiltinsOP(ScopeTable *scopeTable, ast::ASTContext *ctx)
 }
 
 ScopeTable::ScopeTable(NamespaceBuiltinsOverloadToken, ast::ASTContext *context)
-    : _parent(nullptr), _node(nullptr)
+    : _parent(nullptr)
+    , _node(nullptr)
+    , _operatorTable(std::make_unique<OperatorTable>())
+    , _overloadCache(std::make_unique<OverloadCache>())
 {
     registerBinaryBuiltinsOP(this, context);
 }
@@ -75,91 +78,90 @@ public:
         if (skipDefaultImports) {
             return;
         }
-        auto &types
-            = _scopeTable->getModule()->getContext()->getTypesMemoryArena();
+        auto *context = _scopeTable->getModule()->getContext();
         _scopeTable->insertType(
-            "Int", types.create<types::IntTy>(types::IntTy::Signed, 32),
+            "Int", context->getIntType(types::IntTy::Signed, 32),
             ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "UInt", types.create<types::IntTy>(types::IntTy::Unsigned, 32),
+            "UInt", context->getIntType(types::IntTy::Unsigned, 32),
             ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "Float", types.create<types::FloatTy>(types::FloatTy::FLOAT),
+            "Float", context->getFloatType(types::FloatTy::FLOAT),
             ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "Double", types.create<types::FloatTy>(types::FloatTy::DOUBLE),
+            "Double", context->getFloatType(types::FloatTy::DOUBLE),
             ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "Float16", types.create<types::FloatTy>(types::FloatTy::HALF),
+            "Float16", context->getFloatType(types::FloatTy::HALF),
             ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "Float32", types.create<types::FloatTy>(types::FloatTy::FLOAT),
+            "Float32", context->getFloatType(types::FloatTy::FLOAT),
             ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "Float64", types.create<types::FloatTy>(types::FloatTy::DOUBLE),
+            "Float64", context->getFloatType(types::FloatTy::DOUBLE),
             ast::Visibility::Private
         );
         _scopeTable->insertType(
             "Float80",
-            types.create<types::FloatTy>(types::FloatTy::INTEL_LONG_DOUBLE),
+            context->getFloatType(types::FloatTy::INTEL_LONG_DOUBLE),
             ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "Bool", types.create<types::BoolTy>(), ast::Visibility::Private
+            "Bool", context->getBoolType(), ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "Char", types.create<types::CharTy>(), ast::Visibility::Private
+            "Char", context->getCharType(), ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "Void", types.create<types::VoidTy>(), ast::Visibility::Private
+            "Void", context->getVoidType(), ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "Null", types.create<types::NullTy>(), ast::Visibility::Private
+            "Null", context->getNullType(), ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "Int8", types.create<types::IntTy>(types::IntTy::Signed, 8),
+            "Int8", context->getIntType(types::IntTy::Signed, 8),
             ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "Int16", types.create<types::IntTy>(types::IntTy::Signed, 16),
+            "Int16", context->getIntType(types::IntTy::Signed, 16),
             ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "Int32", types.create<types::IntTy>(types::IntTy::Signed, 32),
+            "Int32", context->getIntType(types::IntTy::Signed, 32),
             ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "Int64", types.create<types::IntTy>(types::IntTy::Signed, 64),
+            "Int64", context->getIntType(types::IntTy::Signed, 64),
             ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "Int128", types.create<types::IntTy>(types::IntTy::Signed, 128),
+            "Int128", context->getIntType(types::IntTy::Signed, 128),
             ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "UInt8", types.create<types::IntTy>(types::IntTy::Unsigned, 8),
+            "UInt8", context->getIntType(types::IntTy::Unsigned, 8),
             ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "UInt16", types.create<types::IntTy>(types::IntTy::Unsigned, 16),
+            "UInt16", context->getIntType(types::IntTy::Unsigned, 16),
             ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "UInt32", types.create<types::IntTy>(types::IntTy::Unsigned, 32),
+            "UInt32", context->getIntType(types::IntTy::Unsigned, 32),
             ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "UInt64", types.create<types::IntTy>(types::IntTy::Unsigned, 64),
+            "UInt64", context->getIntType(types::IntTy::Unsigned, 64),
             ast::Visibility::Private
         );
         _scopeTable->insertType(
-            "UInt128", types.create<types::IntTy>(types::IntTy::Unsigned, 128),
+            "UInt128", context->getIntType(types::IntTy::Unsigned, 128),
             ast::Visibility::Private
         );
         if (importManager) {
@@ -173,10 +175,9 @@ public:
                 ast::Visibility::Private
             );
 
-            auto path = _scopeTable->getModule()->getManglingPath();
-            bool isInDefaultImports
-                = llvm::find(path, "defaultImports") != path.end();
-            if (!isInDefaultImports) {
+            if (ImportManager::importsDefaultImports(
+                    _scopeTable->getModule()
+                )) {
                 importManager->handleDefaultImport(_scopeTable);
             }
         }
@@ -184,6 +185,9 @@ public:
 
     void visitModuleDecl(ast::ModuleDecl *node)
     {
+        if (_importManager) {
+            _importManager->prefetchImports(node, _skipPrivateImports);
+        }
         for (auto *decl : node->getDecls()) {
             visit(decl);
         }
@@ -269,7 +273,10 @@ public:
 ScopeTable::ScopeTable(
     ast::ModuleDecl *node, ImportManager *importManager, bool skipPrivateImports
 )
-    : _parent(nullptr), _node(node)
+    : _parent(nullptr)
+    , _node(node)
+    , _operatorTable(std::make_unique<OperatorTable>())
+    , _overloadCache(std::make_unique<OverloadCache>())
 {
     assert(node && "Node must be provided for global scope (ModuleDecl)");
     bool skipDefaultImports = node->isIRDecModule();
@@ -149,6 +149,7 @@ std::optional<ResolvedImport> ImportHandler::loadModule(ResolvedFileImport file)
     if (!scope) {
         return std::nullopt;
     }
+    _manager.recordImportDependency(_importingFileID, file._fileID);
     auto selectorPath = file.selectorPath;
     if (selectorPath.empty()) {
         // Importing the namespace itself
@@ -87,6 +87,18 @@ public:
     /// otherwise.
     std::optional<ResolvedImport> resolveImport();
 
+    /// @brief Resolves the import path to the file that would be imported,
+    /// without loading it.
+    /// @return The FileID of the imported file if found, std::nullopt
+    /// otherwise.
+    std::optional<FileID> resolveImportedFile()
+    {
+        if (auto fileImport = resolveFileImport()) {
+            return fileImport->_fileID;
+        }
+        return std::nullopt;
+    }
+
 private:
     /// @brief Processes the import path and resolves it to a module scope and
     /// selector.
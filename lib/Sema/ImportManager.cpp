@@ -7,6 +7,8 @@
 #include "Lexer/Scanner.hpp"
 #include "Parser/Parser.hpp"
 
+#include "Basic/MemoryArena.hpp"
+
 #include <llvm/ADT/SmallString.h>
 #include <llvm/ADT/SmallVector.h>
 #include <llvm/IR/LLVMContext.h>
@@ -14,6 +16,7 @@
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/Path.h>
 #include <llvm/Support/Program.h>
+#include <llvm/Support/ThreadPool.h>
 #include <llvm/TargetParser/Host.h>
 
 namespace glu::sema {
@@ -65,11 +68,12 @@ bool ImportManager::handleDefaultImport(ScopeTable *intoScope)
         && "SourceManager must be available to handle imports"
     );
     assert(intoScope && "intoScope must be provided for default imports");
+    auto &importStack = getImportStack();
     assert(
-        !_importStack.empty()
+        !importStack.empty()
         && "Import stack must not be empty to handle default imports"
     );
-    FileID importingFileID = _importStack.back();
+    FileID importingFileID = importStack.back();
     llvm::StringRef defaultImportPath[] = { "defaultImports", "@all" };
     ImportHandler handler(*this, importingFileID, defaultImportPath);
     auto result = handler.resolveImport();
@@ -83,32 +87,306 @@ bool ImportManager::handleDefaultImport(ScopeTable *intoScope)
     return true;
 }
 
+/// @brief Collects the imports handled when a module is loaded, the ones in
+/// its namespaces included.
+static void collectImports(
+    llvm::ArrayRef<ast::DeclBase *> decls, bool skipPrivateImports,
+    llvm::SmallVectorImpl<ast::ImportDecl *> &imports
+)
+{
+    for (auto *decl : decls) {
+        if (auto *namespaceDecl = llvm::dyn_cast<ast::NamespaceDecl>(decl)) {
+            collectImports(
+                namespaceDecl->getDecls(), skipPrivateImports, imports
+            );
+        } else if (auto *importDecl = llvm::dyn_cast<ast::ImportDecl>(decl)) {
+            if (!skipPrivateImports || !importDecl->isPrivate()) {
+                imports.push_back(importDecl);
+            }
+        }
+    }
+}
+
+bool ImportManager::importsDefaultImports(ast::ModuleDecl *module)
+{
+    if (module->isIRDecModule()) {
+        return false;
+    }
+    auto path = module->getManglingPath();
+    return llvm::find(path, "defaultImports") == path.end();
+}
+
+void ImportManager::prefetchImports(
+    ast::ModuleDecl *module, bool skipPrivateImports
+)
+{
+    if (getBackgroundLoad()) {
+        // Modules loaded in the background only import loaded modules.
+        return;
+    }
+    llvm::SmallVector<ast::ImportDecl *, 8> imports;
+    collectImports(module->getDecls(), skipPrivateImports, imports);
+
+    llvm::SmallVector<std::pair<SourceLocation, FileID>, 4> foreignSources;
+    llvm::SmallVector<FileID, 4> gluModules;
+    llvm::DenseSet<FileID> seen;
+    for (auto *importDecl : imports) {
+        for (auto selector : importDecl->getImportPath().selectors) {
+            ImportHandler handler(*this, importDecl, selector.name);
+            auto fid = handler.resolveImportedFile();
+            if (!fid || !seen.insert(*fid).second || _importedFiles.lookup(*fid)
+                || _failedImports.contains(*fid)) {
+                continue;
+            }
+            switch (detectModuleType(*fid)) {
+            case ModuleType::GluModule: gluModules.push_back(*fid); break;
+            case ModuleType::CSource:
+            case ModuleType::CxxSource:
+            case ModuleType::RustSource:
+            case ModuleType::ZigSource:
+            case ModuleType::SwiftSource:
+            case ModuleType::DSource:
+                foreignSources.push_back({ importDecl->getLocation(), *fid });
+                break;
+            default: break;
+            }
+        }
+    }
+    // A single foreign import gains nothing from running in the background.
+    if (foreignSources.size() > 1) {
+        prefetchForeignSources(foreignSources);
+    }
+    if (_threadPool && !gluModules.empty()) {
+        prefetchGluModules(gluModules);
+    }
+}
+
+void ImportManager::prefetchGluModules(llvm::ArrayRef<FileID> modules)
+{
+    auto *sm = _context.getSourceManager();
+    llvm::ThreadPoolTaskGroup group(*_threadPool);
+    auto isSettled = [this](FileID fid) {
+        return _importedFiles.lookup(fid) || _failedImports.contains(fid);
+    };
+
+    // Parse the modules, then the modules they import, one level at a time.
+    // Files are registered and read on this thread, between the levels, so
+    // that the workers only read the source manager.
+    llvm::SmallVector<FileID, 8> prefetched;
+    llvm::SmallVector<FileID, 8> level;
+    auto discover = [&](FileID fid) {
+        if (_prefetchedModules.count(fid) || isSettled(fid)
+            || !sm->ensureContentLoaded(fid)) {
+            return;
+        }
+        _prefetchedModules[fid].diagnostics
+            = std::make_unique<DiagnosticManager>(*sm);
+        prefetched.push_back(fid);
+        level.push_back(fid);
+    };
+    for (FileID fid : modules) {
+        discover(fid);
+    }
+    while (!level.empty()) {
+        auto parsed = std::move(level);
+        level.clear();
+        for (FileID fid : parsed) {
+            auto *module = &_prefetchedModules[fid];
+            group.async([this, sm, fid, module] {
+                MemoryArena::ThreadShard shard(_context.getASTMemoryArena());
+                glu::Scanner scanner(
+                    sm->getBuffer(fid), _context.getScannerAllocator()
+                );
+                glu::Parser parser(
+                    scanner, _context, *sm, *module->diagnostics
+                );
+                module->parsed = true;
+                if (parser.parse()) {
+                    module->ast
+                        = llvm::cast_or_null<ast::ModuleDecl>(parser.getAST());
+                }
+            });
+        }
+        group.wait();
+
+        // Imported modules only load their public imports eagerly, and the
+        // default imports unless they are part of them.
+        for (FileID fid : parsed) {
+            auto *ast = _prefetchedModules[fid].ast;
+            if (!ast) {
+                continue;
+            }
+            llvm::SmallVector<ast::ImportDecl *, 8> imports;
+            collectImports(ast->getDecls(), true, imports);
+            llvm::SmallVector<std::optional<FileID>, 8> imported;
+            for (auto *importDecl : imports) {
+                for (auto selector : importDecl->getImportPath().selectors) {
+                    imported.push_back(
+                        ImportHandler(*this, importDecl, selector.name)
+                            .resolveImportedFile()
+                    );
+                }
+            }
+            if (importsDefaultImports(ast)) {
+                llvm::StringRef defaultImportPath[]
+                    = { "defaultImports", "@all" };
+                imported.push_back(
+                    ImportHandler(*this, fid, defaultImportPath)
+                        .resolveImportedFile()
+                );
+            }
+
+            llvm::SmallVector<FileID, 4> dependencies;
+            bool blocked = false;
+            for (auto dep : imported) {
+                if (!dep || isSettled(*dep)) {
+                    continue;
+                }
+                if (detectModuleType(*dep) != ModuleType::GluModule) {
+                    blocked = true;
+                    continue;
+                }
+                dependencies.push_back(*dep);
+                discover(*dep);
+            }
+            auto &module = _prefetchedModules[fid];
+            module.dependencies = std::move(dependencies);
+            module.blocked = blocked;
+        }
+    }
+
+    // Load the modules whose imports are all loaded, until none is left.
+    // The others are in a cycle or import one, and are left to the main
+    // thread, which detects the cycle.
+    llvm::SmallVector<FileID, 8> pending = prefetched;
+    while (true) {
+        llvm::SmallVector<FileID, 8> ready;
+        for (FileID fid : pending) {
+            auto &module = _prefetchedModules[fid];
+            if (module.ast && !module.blocked
+                && llvm::all_of(module.dependencies, isSettled)) {
+                ready.push_back(fid);
+            }
+        }
+        if (ready.empty()) {
+            break;
+        }
+        llvm::erase_if(pending, [&](FileID fid) {
+            return llvm::is_contained(ready, fid);
+        });
+
+        std::vector<ScopeTable *> scopes(ready.size());
+        std::vector<BackgroundLoad> loads(ready.size());
+        for (size_t i = 0; i < ready.size(); ++i) {
+            auto *module = &_prefetchedModules[ready[i]];
+            _backgroundScopeTableAllocators.push_back(
+                std::make_unique<llvm::SpecificBumpPtrAllocator<ScopeTable>>()
+            );
+            auto &load = loads[i];
+            load.manager = this;
+            load.importStack.push_back(ready[i]);
+            load.diagnostics = std::make_unique<DiagnosticManager>(*sm);
+            load.scopeTableAllocator
+                = _backgroundScopeTableAllocators.back().get();
+            group.async([this, &scopes, &load, i, module] {
+                MemoryArena::ThreadShard shard(_context.getASTMemoryArena());
+                _backgroundLoad = &load;
+                scopes[i] = sema::fastConstrainAST(
+                    module->ast, *load.diagnostics, this
+                );
+                _backgroundLoad = nullptr;
+            });
+        }
+        group.wait();
+
+        for (size_t i = 0; i < ready.size(); ++i) {
+            auto &load = loads[i];
+            auto &module = _prefetchedModules[ready[i]];
+            if (load.abandoned) {
+                // Drop everything the load did: the main thread parses and
+                // loads the module again, reporting its diagnostics.
+                module.blocked = true;
+                module.parsed = false;
+                module.ast = nullptr;
+                module.diagnostics.reset();
+                continue;
+            }
+            module.loaded = true;
+            module.diagnostics->takeDiagnostics(*load.diagnostics);
+            _skippedImports.append(
+                load.skippedImports.begin(), load.skippedImports.end()
+            );
+            _implementImports.append(
+                load.implementImports.begin(), load.implementImports.end()
+            );
+            for (auto [importingFile, importedFile] : load.importDependencies) {
+                recordImportDependency(importingFile, importedFile);
+            }
+            if (scopes[i]) {
+                _importedFiles[ready[i]] = scopes[i];
+            } else {
+                _failedImports.insert(ready[i]);
+            }
+        }
+    }
+}
+
+void ImportManager::reportPrefetchedDiagnostics(FileID fid)
+{
+    auto it = _prefetchedModules.find(fid);
+    if (it == _prefetchedModules.end() || !it->second.diagnostics) {
+        return;
+    }
+    auto diagnostics = std::move(it->second.diagnostics);
+    if (it->second.loaded) {
+        // Its imports were loaded before it, as they would have been while
+        // loading it on this thread.
+        auto dependencies = it->second.dependencies;
+        for (FileID dep : dependencies) {
+            reportPrefetchedDiagnostics(dep);
+        }
+    }
+    _diagManager.takeDiagnostics(*diagnostics);
+}
+
 // MARK: - Import File Loading
 
 std::optional<glu::sema::ScopeTable *>
 ImportManager::tryLoadingFile(SourceLocation importLoc, FileID fid)
 {
+    if (!getBackgroundLoad()) {
+        reportPrefetchedDiagnostics(fid);
+    }
     if (_failedImports.contains(fid)) {
         // Previous import failed, do not try again. Do not generate new errors.
         return std::nullopt;
     }
-    if (std::find(_importStack.begin(), _importStack.end(), fid)
-        != _importStack.end()) {
+    auto &importStack = getImportStack();
+    if (std::find(importStack.begin(), importStack.end(), fid)
+        != importStack.end()) {
         // Cyclic import detected.
-        _diagManager.error(
+        getDiagnosticManager().error(
             importLoc,
             "Cyclic import detected, module may be re-exporting itself"
         );
         return std::nullopt;
     }
-    if (!_importedFiles[fid]) {
-        // File has not been imported yet.
-        if (!loadModule(importLoc, fid, detectModuleType(fid))) {
-            _failedImports.insert(fid);
-            return std::nullopt; // Import failed.
-        }
+    if (auto *scope = _importedFiles.lookup(fid)) {
+        // File has already been imported.
+        return scope;
+    }
+    // File has not been imported yet.
+    if (auto *load = getBackgroundLoad()) {
+        // prefetchGluModules did not expect this import. Loading the file
+        // here would race with the other background loads, so the main
+        // thread loads the importing module instead.
+        load->abandoned = true;
+        return std::nullopt;
+    }
+    if (!loadModule(importLoc, fid, detectModuleType(fid))) {
+        _failedImports.insert(fid);
+        return std::nullopt; // Import failed.
     }
-    // File has already been imported.
     return _importedFiles[fid];
 }
 
@@ -161,19 +439,36 @@ bool ImportManager::loadModule(
 
 bool ImportManager::loadGluModule(FileID fid)
 {
-    auto *sm = _context.getSourceManager();
-    auto contentLoaded = sm->ensureContentLoaded(fid);
-    if (!contentLoaded) {
-        return false;
-    }
-    glu::Scanner scanner(sm->getBuffer(fid), _context.getScannerAllocator());
-    glu::Parser parser(scanner, _context, *sm, _diagManager);
-    if (!parser.parse()) {
-        return false;
-    }
-    auto *ast = llvm::cast<ast::ModuleDecl>(parser.getAST());
-    if (!ast) {
-        return false;
+    ast::ModuleDecl *ast;
+    auto prefetched = _prefetchedModules.find(fid);
+    if (prefetched != _prefetchedModules.end() && prefetched->second.parsed) {
+        // Parsed in the background, but left to this thread to load.
+        reportPrefetchedDiagnostics(fid);
+        ast = prefetched->second.ast;
+        _prefetchedModules.erase(prefetched);
+        if (!ast) {
+            return false;
+        }
+    } else {
+        if (prefetched != _prefetchedModules.end()) {
+            _prefetchedModules.erase(prefetched);
+        }
+        auto *sm = _context.getSourceManager();
+        auto contentLoaded = sm->ensureContentLoaded(fid);
+        if (!contentLoaded) {
+            return false;
+        }
+        glu::Scanner scanner(
+            sm->getBuffer(fid), _context.getScannerAllocator()
+        );
+        glu::Parser parser(scanner, _context, *sm, _diagManager);
+        if (!parser.parse()) {
+            return false;
+        }
+        ast = llvm::cast<ast::ModuleDecl>(parser.getAST());
+        if (!ast) {
+            return false;
+        }
     }
     _importStack.push_back(fid);
     _importedFiles[fid] = sema::fastConstrainAST(ast, _diagManager, this);
@@ -260,7 +555,8 @@ void ImportManager::importModuleIntoScope(
         intoScope->insertNamespace(namespaceName, module, visibility);
         // Copy operator overloads into the scope directly.
         module->copyInto(
-            intoScope, isOperatorOverload, _diagManager, importLoc, visibility
+            intoScope, isOperatorOverload, getDiagnosticManager(), importLoc,
+            visibility
         );
         return;
     }
@@ -274,16 +570,17 @@ void ImportManager::importModuleIntoScope(
         };
     }
     if (!module->copyInto(
-            intoScope, selectorFunc, _diagManager, importLoc, visibility
+            intoScope, selectorFunc, getDiagnosticManager(), importLoc,
+            visibility
         )) {
         // No elements were imported.
         if (selector == "@all") {
-            _diagManager.error(
+            getDiagnosticManager().error(
                 importLoc,
                 "Could not find any public declarations in imported module"
             );
         } else {
-            _diagManager.error(
+            getDiagnosticManager().error(
                 importLoc,
                 "Could not find '" + selector + "' in imported module"
             );
@@ -300,7 +597,7 @@ void ImportManager::recordImplementImport(
     SourceLocation importLoc = importDecl->getLocation();
     // @implement cannot use namespace imports (empty selector)
     if (selector.empty()) {
-        _diagManager.error(
+        getDiagnosticManager().error(
             importLoc,
             "@implement import cannot import a namespace; "
             "specify function names explicitly"
@@ -309,7 +606,7 @@ void ImportManager::recordImplementImport(
     }
     // @implement cannot use wildcards
     if (selector == "@all") {
-        _diagManager.error(
+        getDiagnosticManager().error(
             importLoc,
             "@implement import cannot use wildcard imports; "
             "specify function names explicitly"
@@ -319,7 +616,7 @@ void ImportManager::recordImplementImport(
     // Find the function being imported
     auto *item = importedModule->lookupItem(selector);
     if (!item || item->decls.empty()) {
-        _diagManager.error(
+        getDiagnosticManager().error(
             importLoc,
             "Could not find function '" + selector + "' in imported module"
         );
@@ -334,7 +631,7 @@ void ImportManager::recordImplementImport(
         }
     }
     if (!importedFunc) {
-        _diagManager.error(
+        getDiagnosticManager().error(
             importLoc,
             "'" + selector
                 + "' is not a function; @implement can only be "
@@ -343,22 +640,78 @@ void ImportManager::recordImplementImport(
         return;
     }
     // Track this @implement import
-    _implementImports.push_back(
-        ImplementImportInfo { importDecl, importedFunc, intoScope, selector,
-                              effectiveName }
-    );
+    ImplementImportInfo info { importDecl, importedFunc, intoScope, selector,
+                               effectiveName };
+    if (auto *load = getBackgroundLoad()) {
+        load->implementImports.push_back(info);
+        return;
+    }
+    _implementImports.push_back(info);
 }
 
-bool ImportManager::processSkippedImports()
+llvm::SmallVector<FileID, 8> ImportManager::collectLinkedFiles(
+    llvm::ArrayRef<ast::ModuleDecl *> referencedModules
+)
 {
-    while (!_skippedImports.empty()) {
-        auto *decl = _skippedImports.back();
-        _skippedImports.pop_back();
-        if (!handleImport(decl, nullptr)) {
-            return false;
+    auto *sm = _context.getSourceManager();
+    FileID mainFile = sm->getMainFileID();
+
+    llvm::DenseMap<ast::ModuleDecl *, FileID> moduleFiles;
+    for (auto const &[fid, scope] : _importedFiles) {
+        if (scope) {
+            moduleFiles[scope->getModule()] = fid;
         }
     }
-    return true;
+
+    llvm::SmallVector<FileID, 8> linked;
+    llvm::DenseSet<FileID> visited;
+    llvm::SmallVector<FileID, 8> worklist;
+    auto enqueue = [&](FileID fid) {
+        if (visited.insert(fid).second) {
+            worklist.push_back(fid);
+        }
+    };
+    // The main module is linked already, and its own imports are only linked
+    // if referenced. The modules usually come from a pointer set, so they
+    // are sorted by file to keep the link order stable across runs.
+    visited.insert(mainFile);
+    llvm::SmallVector<FileID, 8> referencedFiles;
+    for (auto *module : referencedModules) {
+        auto it = moduleFiles.find(module);
+        if (it != moduleFiles.end()) {
+            referencedFiles.push_back(it->second);
+        }
+    }
+    llvm::sort(referencedFiles);
+    // The worklist is a stack: push the first file last.
+    for (FileID fid : llvm::reverse(referencedFiles)) {
+        enqueue(fid);
+    }
+
+    while (!worklist.empty()) {
+        FileID fid = worklist.pop_back_val();
+        linked.push_back(fid);
+        // The object file of this module may need its private imports.
+        // Loading them may append to _skippedImports, so index the vector.
+        for (size_t i = 0; i < _skippedImports.size(); ++i) {
+            auto *decl = _skippedImports[i];
+            if (decl && sm->getFileID(decl->getLocation()) == fid) {
+                _skippedImports[i] = nullptr;
+                handleImport(decl, nullptr);
+            }
+        }
+        auto deps = _importDependencies.find(fid);
+        if (deps == _importDependencies.end()) {
+            continue;
+        }
+        for (FileID dep : deps->second) {
+            enqueue(dep);
+        }
+    }
+    llvm::erase_if(_skippedImports, [](ast::ImportDecl *decl) {
+        return decl == nullptr;
+    });
+    return linked;
 }
 
 } // namespace glu::sema
@@ -6,6 +6,7 @@
 
 #include "SemanticPass/DuplicateFunctionChecker.hpp"
 #include "SemanticPass/EnumValueResolver.hpp"
+#include "SemanticPass/FusedChecker.hpp"
 #include "SemanticPass/ImmutableAssignmentWalker.hpp"
 #include "SemanticPass/ImplementImportWrapper.hpp"
 #include "SemanticPass/InitializerWalker.hpp"
@@ -19,13 +20,16 @@
 #include "SemanticPass/ValidMainChecker.hpp"
 #include "SemanticPass/ValidTypeChecker.hpp"
 
+#include <llvm/Support/ThreadPool.h>
 #include <llvm/Support/WithColor.h>
 
+#include <memory>
+
 namespace glu::sema {
 
 /// @brief Walks the AST to build scope tables and run local constraint
 /// systems. Runs the whole Sema pipeline.
-class ModuleWalker : public glu::ast::ASTWalker<ModuleWalker, void> {
+class ModuleWalker : public glu::ast::IterativeASTWalker<ModuleWalker> {
     ScopeTable *_scopeTable;
     glu::DiagnosticManager &_diagManager;
     glu::ast::ASTContext *_context;
@@ -35,19 +39,23 @@ class ModuleWalker : public glu::ast::ASTWalker<ModuleWalker, void> {
     bool _skipBodies = false;
     bool _skippingCurrentFunction = false;
 
-    llvm::raw_ostream *_dumpConstraints
-        = nullptr; ///< Whether to dump constraints
+    SolverOptions _solverOptions; ///< Options of the local constraint systems
+
+    /// @brief Function bodies left to check concurrently, with the scope they
+    /// are declared in.
+    std::vector<std::pair<glu::ast::FunctionDecl *, ScopeTable *>>
+        _deferredFunctions;
 
 public:
     ModuleWalker(
         glu::DiagnosticManager &diagManager, glu::ast::ASTContext *context,
-        ImportManager *importManager, bool dumpConstraints = false
+        ImportManager *importManager, SolverOptions const &solverOptions = {}
     )
         : _diagManager(diagManager)
         , _context(context)
         , _importManager(importManager)
         , _globalScopeAllocator(importManager->getScopeTableAllocator())
-        , _dumpConstraints(dumpConstraints ? &llvm::outs() : nullptr)
+        , _solverOptions(solverOptions)
     {
     }
 
@@ -74,18 +82,24 @@ public:
 
     void postVisitModuleDecl([[maybe_unused]] glu::ast::ModuleDecl *node)
     {
-        // Link drop/copy functions to their struct types (needed for all
-        // modules)
-        ValidDropOverloadChecker(_diagManager).visit(node);
-        ValidCopyOverloadChecker(_diagManager).visit(node);
-
-        if (!_skipBodies) {
-            // These checks don't need to run on imported modules
-            InitializerWalker(_diagManager).visit(node);
-            ValidAttributeChecker(_diagManager).visit(node);
-            ValidMainChecker(_diagManager).visit(node);
-            DuplicateFunctionChecker(_diagManager).visit(node);
-            InvalidOperatorArgsChecker(_diagManager).visit(node);
+        checkDeferredFunctions();
+
+        if (_skipBodies) {
+            // Link drop/copy functions to their struct types (needed for all
+            // modules)
+            FusedChecker<ValidDropOverloadChecker, ValidCopyOverloadChecker>(
+                _diagManager
+            )
+                .visit(node);
+        } else {
+            // The other checks don't need to run on imported modules
+            FusedChecker<
+                ValidDropOverloadChecker, ValidCopyOverloadChecker,
+                InitializerWalker, ValidAttributeChecker, ValidMainChecker,
+                DuplicateFunctionChecker, InvalidOperatorArgsChecker>(
+                _diagManager
+            )
+                .visit(node);
             ImplementImportWrapper(*_importManager, _scopeTable, node)
                 .process();
 
@@ -94,7 +108,74 @@ public:
             for (auto *synthetic : _scopeTable->getSyntheticFunctions()) {
                 visit(synthetic);
             }
+            checkDeferredFunctions();
+        }
+    }
+
+    /// @brief Whether a function body should be checked later, concurrently
+    /// with the other bodies of the module.
+    bool shouldDeferFunction(glu::ast::FunctionDecl *node)
+    {
+        // Constraint dumps must come out in source order
+        if (!_solverOptions.threadPool || _solverOptions.dumpConstraints)
+            return false;
+        if (!node->getBody() || shouldSkipFunction(node))
+            return false;
+        // The scope must outlive the walk of the module
+        return _scopeTable->isGlobalScope()
+            || llvm::isa<glu::ast::NamespaceDecl>(_scopeTable->getNode());
+    }
+
+    void _visitFunctionDecl(glu::ast::FunctionDecl *node)
+    {
+        if (shouldDeferFunction(node)) {
+            _deferredFunctions.push_back({ node, _scopeTable });
+            return;
         }
+        ASTWalker::_visitFunctionDecl(node);
+    }
+
+    /// @brief Checks the deferred function bodies concurrently. Once global
+    /// declarations are resolved, bodies only share read-only scopes and
+    /// thread-safe arenas. Each body is checked by its own walker and reports
+    /// to its own diagnostics, merged back in source order. The bodies are
+    /// spread over the pool already, so each one solves its statements in
+    /// order.
+    void checkDeferredFunctions()
+    {
+        if (_deferredFunctions.empty())
+            return;
+        auto functions = std::move(_deferredFunctions);
+        _deferredFunctions.clear();
+
+        SolverOptions bodyOptions = _solverOptions;
+        bodyOptions.threadPool = nullptr;
+
+        std::vector<std::unique_ptr<DiagnosticManager>> diagnostics;
+        for (size_t i = 0; i < functions.size(); ++i) {
+            diagnostics.push_back(
+                std::make_unique<DiagnosticManager>(
+                    _diagManager.getSourceManager()
+                )
+            );
+        }
+
+        llvm::ThreadPoolTaskGroup group(*_solverOptions.threadPool);
+        for (size_t i = 0; i < functions.size(); ++i) {
+            group.async([this, &functions, &diagnostics, &bodyOptions, i] {
+                auto [function, scope] = functions[i];
+                MemoryArena::ThreadShard shard(_context->getASTMemoryArena());
+                ModuleWalker walker(
+                    *diagnostics[i], _context, _importManager, bodyOptions
+                );
+                walker._scopeTable = scope;
+                walker.visit(function);
+            });
+        }
+        group.wait();
+
+        for (auto &functionDiagnostics : diagnostics)
+            _diagManager.takeDiagnostics(*functionDiagnostics);
     }
 
     void preVisitFunctionDecl(glu::ast::FunctionDecl *node)
@@ -114,11 +195,12 @@ public:
             _skippingCurrentFunction = false;
             return;
         }
-        UnreachableWalker(_diagManager).visit(node);
-        UnreferencedVarDeclWalker(_diagManager).visit(node);
-        ImmutableAssignmentWalker(_diagManager).visit(node);
-        ValidLiteralChecker(_diagManager).visit(node);
-        ValidTypeChecker(_diagManager).visit(node);
+        FusedChecker<
+            UnreachableWalker, UnreferencedVarDeclWalker,
+            ImmutableAssignmentWalker, ValidLiteralChecker, ValidTypeChecker>(
+            _diagManager
+        )
+            .visit(node);
         _scopeTable = _scopeTable->getParent();
         _localScopeAllocator.DestroyAll();
     }
@@ -231,7 +313,7 @@ public:
         if (node->isGlobal()) {
             ScopeTable local(_scopeTable, node);
             runLocalCSWalker(
-                &local, node, _diagManager, _context, _dumpConstraints
+                &local, node, _diagManager, _context, _solverOptions
             );
         }
     }
@@ -241,7 +323,7 @@ public:
         if (llvm::isa<ast::StructDecl>(node->getParent())) {
             ScopeTable local(_scopeTable, node);
             runLocalCSWalker(
-                &local, node, _diagManager, _context, _dumpConstraints
+                &local, node, _diagManager, _context, _solverOptions
             );
         }
     }
@@ -252,7 +334,7 @@ public:
         if (node->getValue()) {
             ScopeTable local(_scopeTable, node);
             runLocalCSWalker(
-                &local, node, _diagManager, _context, _dumpConstraints
+                &local, node, _diagManager, _context, _solverOptions
             );
         }
         // Call parent class handler for VarLetDecl
@@ -265,7 +347,7 @@ public:
             return;
         ScopeTable local(_scopeTable, node);
         runLocalCSWalker(
-            &local, node, _diagManager, _context, _dumpConstraints
+            &local, node, _diagManager, _context, _solverOptions
         );
     }
 };
@@ -278,16 +360,18 @@ void constrainAST(
     ImportManager importManager(
         *module->getContext(), diagManager, importPaths, ""
     );
-    constrainAST(module, diagManager, &importManager, dumpConstraints);
+    SolverOptions options;
+    options.dumpConstraints = dumpConstraints;
+    constrainAST(module, diagManager, &importManager, options);
 }
 
 ScopeTable *constrainAST(
     glu::ast::ModuleDecl *module, glu::DiagnosticManager &diagManager,
-    ImportManager *importManager, bool dumpConstraints
+    ImportManager *importManager, SolverOptions const &options
 )
 {
     ModuleWalker walker(
-        diagManager, module->getContext(), importManager, dumpConstraints
+        diagManager, module->getContext(), importManager, options
     );
     walker.visit(module);
     return walker.getScopeTable();
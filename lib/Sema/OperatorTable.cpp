@@ -0,0 +1,89 @@
+#include "OperatorTable.hpp"
+#include "ScopeTable.hpp"
+
+namespace glu::sema {
+
+/// @brief The type constructor a parameter type is indexed by, or none if
+/// the parameter may take an operand of any type constructor.
+static std::optional<types::TypeKind> getIndexedKind(types::TypeBase *type)
+{
+    while (auto *alias = llvm::dyn_cast<types::TypeAliasTy>(type))
+        type = alias->getWrappedType();
+
+    if (llvm::isa<
+            types::TypeVariableTy, types::TemplateParamTy,
+            types::UnresolvedNameTy>(type))
+        return std::nullopt;
+    return type->getKind();
+}
+
+/// @brief The type constructors of the parameters an operand of the given
+/// type constructor implicitly converts to, itself included. This mirrors
+/// the implicit conversions accepted by the ConversionVisitor.
+static llvm::SmallVector<types::TypeKind, 2>
+getImplicitTargetKinds(types::TypeKind kind)
+{
+    using types::TypeKind;
+
+    switch (kind) {
+    case TypeKind::IntTyKind: return { kind, TypeKind::CharTyKind };
+    case TypeKind::CharTyKind: return { kind, TypeKind::IntTyKind };
+    case TypeKind::StaticArrayTyKind: return { kind, TypeKind::PointerTyKind };
+    case TypeKind::PointerTyKind: return { kind, TypeKind::FunctionTyKind };
+    case TypeKind::NullTyKind: return { kind, TypeKind::PointerTyKind };
+    default: return { kind };
+    }
+}
+
+OperatorOverloadIndex::OperatorOverloadIndex(ScopeItem const &item)
+    : _declCount(item.decls.size())
+{
+    for (auto const &decl : item.decls) {
+        auto *fnDecl = llvm::dyn_cast<ast::FunctionDecl>(decl.item);
+        if (!fnDecl)
+            continue;
+
+        auto *fnTy = fnDecl->getType();
+        auto kind = fnTy->getParameterCount() == 0
+            ? std::nullopt
+            : getIndexedKind(fnTy->getParameter(0));
+        if (kind)
+            _byFirstParam[static_cast<unsigned>(*kind)].push_back(fnDecl);
+        else
+            _generic.push_back(fnDecl);
+    }
+}
+
+void OperatorOverloadIndex::getCandidates(
+    types::TypeBase *operandType,
+    llvm::SmallPtrSetImpl<ast::FunctionDecl *> &candidates
+) const
+{
+    candidates.insert(_generic.begin(), _generic.end());
+
+    auto operandKind = getIndexedKind(operandType);
+    if (!operandKind) {
+        for (auto const &bucket : _byFirstParam)
+            candidates.insert(bucket.second.begin(), bucket.second.end());
+        return;
+    }
+
+    for (auto kind : getImplicitTargetKinds(*operandKind)) {
+        auto it = _byFirstParam.find(static_cast<unsigned>(kind));
+        if (it != _byFirstParam.end())
+            candidates.insert(it->second.begin(), it->second.end());
+    }
+}
+
+OperatorOverloadIndex const &OperatorTable::getOverloads(ScopeItem const &item)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto &index = _indexes[&item];
+    if (index && index->getDeclCount() != item.decls.size())
+        _staleIndexes.push_back(std::move(index));
+    if (!index)
+        index = std::make_unique<OperatorOverloadIndex>(item);
+    return *index;
+}
+
+} // namespace glu::sema
@@ -19,9 +19,7 @@ class EnumValueResolver : public ast::ASTWalker<EnumValueResolver, void> {
         auto *repr = node->getRepresentableType();
         if (repr)
             return repr->getCanonicalType(ctx);
-        return ctx.getTypesMemoryArena().create<types::IntTy>(
-            types::IntTy::Signed, 32
-        );
+        return ctx.getIntType(types::IntTy::Signed, 32);
     }
 
     /// @brief Gets the bit width from a representable type.
@@ -0,0 +1,76 @@
+#ifndef GLU_SEMA_SEMANTICPASS_FUSEDCHECKER_HPP
+#define GLU_SEMA_SEMANTICPASS_FUSEDCHECKER_HPP
+
+#include "AST/ASTWalker.hpp"
+#include "Basic/Diagnostic.hpp"
+
+#include <tuple>
+
+namespace glu::sema {
+
+/// @brief Runs several checkers in a single traversal of the AST.
+///
+/// Each node is dispatched to the pre/post visit methods of every checker, in
+/// the order the checkers are listed, so that running them together is
+/// equivalent to running them one after the other, with one walk instead of
+/// one per checker. Checkers must not override the traversal itself
+/// (_visit methods), since they all share this one.
+/// @tparam Checkers The ASTWalker checkers to run, each constructible from a
+/// DiagnosticManager.
+template <typename... Checkers>
+class FusedChecker : public ast::IterativeASTWalker<FusedChecker<Checkers...>> {
+    std::tuple<Checkers...> _checkers;
+
+    template <typename Checker>
+    static DiagnosticManager &argumentFor(DiagnosticManager &diagManager)
+    {
+        return diagManager;
+    }
+
+    template <typename Fn> void forEachChecker(Fn &&fn)
+    {
+        std::apply(
+            [&fn](auto &...checkers) { (fn(checkers), ...); }, _checkers
+        );
+    }
+
+public:
+    /// @brief Constructs every checker with the same diagnostic manager.
+    explicit FusedChecker(DiagnosticManager &diagManager)
+        : _checkers(argumentFor<Checkers>(diagManager)...)
+    {
+    }
+
+    void beforeVisitNode(ast::ASTNode *node)
+    {
+        forEachChecker([node](auto &checker) {
+            checker.beforeVisitNode(node);
+        });
+    }
+
+    void afterVisitNode(ast::ASTNode *node)
+    {
+        forEachChecker([node](auto &checker) {
+            checker.afterVisitNode(node);
+        });
+    }
+
+#define NODE_KIND(Name, Parent)                                   \
+    void preVisit##Name(ast::Name *node)                          \
+    {                                                             \
+        forEachChecker([node](auto &checker) {                    \
+            checker.preVisit##Name(node);                         \
+        });                                                       \
+    }                                                             \
+    void postVisit##Name(ast::Name *node)                         \
+    {                                                             \
+        forEachChecker([node](auto &checker) {                    \
+            checker.postVisit##Name(node);                        \
+        });                                                       \
+    }
+#include "NodeKind.def"
+};
+
+} // namespace glu::sema
+
+#endif // GLU_SEMA_SEMANTICPASS_FUSEDCHECKER_HPP
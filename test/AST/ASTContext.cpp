@@ -7,6 +7,9 @@
 #include <gtest/gtest.h>
 #include <llvm/Support/Casting.h>
 
+#include <thread>
+#include <vector>
+
 using namespace glu::ast;
 using namespace glu::types;
 
@@ -204,3 +207,84 @@ TEST(ASTContext_TypesMemoryArena, InternUnresolvedNameTy)
     ASSERT_EQ(name1, name2);
     ASSERT_NE(name1, nameDiff);
 }
+
+TEST(ASTContext_TypesMemoryArena, StoredHashMatchesStructure)
+{
+    ASTContext ctx;
+    ASTContext otherCtx;
+
+    auto boolType = ctx.getTypesMemoryArena().create<BoolTy>();
+    auto fctType = ctx.getTypesMemoryArena().create<FunctionTy>(
+        std::vector<TypeBase *> { boolType, boolType }, boolType
+    );
+    auto sameFctType = otherCtx.getTypesMemoryArena().create<FunctionTy>(
+        std::vector<TypeBase *> { boolType, boolType }, boolType
+    );
+
+    ASSERT_NE(fctType, sameFctType);
+    ASSERT_EQ(fctType->hash(), fctType->hash());
+    ASSERT_EQ(fctType->hash(), sameFctType->hash());
+    ASSERT_TRUE(*fctType == *sameFctType);
+}
+
+TEST(ASTContext, PrimitiveTypesAreInterned)
+{
+    ASTContext ctx;
+    auto &types = ctx.getTypesMemoryArena();
+
+    ASSERT_EQ(ctx.getBoolType(), types.create<BoolTy>());
+    ASSERT_EQ(ctx.getCharType(), types.create<CharTy>());
+    ASSERT_EQ(ctx.getVoidType(), types.create<VoidTy>());
+    ASSERT_EQ(ctx.getNullType(), types.create<NullTy>());
+    ASSERT_EQ(
+        ctx.getIntType(IntTy::Signed, 32),
+        types.create<IntTy>(IntTy::Signed, 32)
+    );
+    ASSERT_EQ(
+        ctx.getIntType(IntTy::Unsigned, 128),
+        types.create<IntTy>(IntTy::Unsigned, 128)
+    );
+    ASSERT_EQ(
+        ctx.getIntType(IntTy::Unsigned, 24),
+        types.create<IntTy>(IntTy::Unsigned, 24)
+    );
+    ASSERT_EQ(
+        ctx.getFloatType(FloatTy::DOUBLE),
+        types.create<FloatTy>(FloatTy::DOUBLE)
+    );
+    ASSERT_NE(
+        ctx.getIntType(IntTy::Signed, 64), ctx.getIntType(IntTy::Signed, 8)
+    );
+}
+
+TEST(ASTContext_TypesMemoryArena, InternFromSeveralThreads)
+{
+    ASTContext ctx;
+    constexpr unsigned threadCount = 8;
+    constexpr unsigned typeCount = 256;
+    std::vector<std::vector<TypeBase *>> created(threadCount);
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&ctx, &types = created[t]] {
+            auto &arena = ctx.getTypesMemoryArena();
+            for (unsigned width = 1; width <= typeCount; ++width) {
+                auto *intType = arena.create<IntTy>(IntTy::Signed, width);
+                types.push_back(arena.create<PointerTy>(intType));
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    for (unsigned t = 1; t < threadCount; ++t)
+        ASSERT_EQ(created[t], created[0]);
+    for (unsigned width = 1; width <= typeCount; ++width) {
+        auto *intType
+            = ctx.getTypesMemoryArena().create<IntTy>(IntTy::Signed, width);
+        ASSERT_EQ(
+            ctx.getTypesMemoryArena().create<PointerTy>(intType),
+            created[0][width - 1]
+        );
+    }
+}
@@ -0,0 +1,80 @@
+#include "AST/ASTStatistics.hpp"
+#include "AST/ASTContext.hpp"
+#include "AST/Decls.hpp"
+#include "AST/Exprs.hpp"
+#include "AST/Stmts.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace glu::ast;
+using namespace glu::types;
+
+class ASTStatisticsTest : public ::testing::Test {
+protected:
+    ASTContext ctx;
+    LiteralExpr *literal;
+    ModuleDecl *module;
+
+    ASTStatisticsTest()
+    {
+        auto &ast = ctx.getASTMemoryArena();
+        auto *intType = ctx.getIntType(IntTy::Signed, 32);
+        literal = ast.create<LiteralExpr>(
+            llvm::APInt(32, 42), intType, glu::SourceLocation(3)
+        );
+        auto *body = ast.create<CompoundStmt>(
+            glu::SourceLocation(2),
+            llvm::SmallVector<StmtBase *> {
+                ast.create<ReturnStmt>(glu::SourceLocation(3), literal) }
+        );
+        auto *func = ast.create<FunctionDecl>(
+            glu::SourceLocation(1), nullptr, "f",
+            ctx.getTypesMemoryArena().create<FunctionTy>(
+                llvm::ArrayRef<TypeBase *> {}, intType
+            ),
+            llvm::ArrayRef<ParamDecl *> {}, body
+        );
+        module = ast.create<ModuleDecl>(
+            glu::SourceLocation(0), llvm::ArrayRef<DeclBase *> { func }, &ctx
+        );
+    }
+};
+
+TEST_F(ASTStatisticsTest, GetModuleFromNestedNode)
+{
+    ASSERT_EQ(module->getModule(), module);
+    ASSERT_EQ(literal->getModule(), module);
+    // The module is now cached on the function containing the literal.
+    ASSERT_EQ(literal->getParent()->getModule(), module);
+    ASSERT_EQ(module->getDecls()[0]->getModule(), module);
+}
+
+TEST_F(ASTStatisticsTest, CountsNodesAndTypes)
+{
+    ASTStatistics stats;
+    stats.addModule(module);
+    stats.addContext(ctx);
+
+    for (auto kind :
+         { NodeKind::ModuleDeclKind, NodeKind::FunctionDeclKind,
+           NodeKind::CompoundStmtKind, NodeKind::ReturnStmtKind,
+           NodeKind::LiteralExprKind }) {
+        ASSERT_EQ(stats.getNodeStatistics(kind).count, 1u);
+    }
+    ASSERT_EQ(stats.getNodeStatistics(NodeKind::IfStmtKind).count, 0u);
+    ASSERT_EQ(
+        stats.getNodeStatistics(NodeKind::CompoundStmtKind).bytes,
+        sizeof(CompoundStmt) + sizeof(StmtBase *)
+    );
+
+    auto const &functions = stats.getTypeStatistics(TypeKind::FunctionTyKind);
+    ASSERT_EQ(functions.count, 1u);
+    ASSERT_EQ(functions.bytes, sizeof(FunctionTy));
+    ASSERT_GE(stats.getTypeStatistics(TypeKind::IntTyKind).count, 1u);
+
+    std::string output;
+    llvm::raw_string_ostream os(output);
+    stats.print(os);
+    ASSERT_NE(output.find("LiteralExpr"), std::string::npos);
+    ASSERT_NE(output.find("FunctionTy"), std::string::npos);
+}
@@ -32,13 +32,11 @@ struct TestVisitor : public ASTWalker<TestVisitor> {
     }
 };
 
-TEST(ASTWalker, Example)
+static ASTNode *createExampleTree(ASTContext &ctx)
 {
-    TestVisitor visitor;
-    ASTContext ctx;
     auto &ast = ctx.getASTMemoryArena();
 
-    ASTNode *node = ast.create<IfStmt>(
+    return ast.create<IfStmt>(
         glu::SourceLocation(1),
         ast.create<LiteralExpr>(
             true, ctx.getTypesMemoryArena().create<glu::types::BoolTy>(),
@@ -67,6 +65,13 @@ TEST(ASTWalker, Example)
             glu::SourceLocation(4), llvm::SmallVector<StmtBase *> {}
         )
     );
+}
+
+TEST(ASTWalker, Example)
+{
+    TestVisitor visitor;
+    ASTContext ctx;
+    ASTNode *node = createExampleTree(ctx);
 
     visitor.visit(node);
     EXPECT_EQ(
@@ -81,3 +86,71 @@ TEST(ASTWalker, Example)
         "  Visiting Node with Kind 10\n"
     );
 }
+
+// Records the order of the callbacks, with either traversal
+#define TRACE_CALLBACKS                                                    \
+    std::string trace;                                                     \
+    void beforeVisitNode(ASTNode *node)                                    \
+    {                                                                      \
+        trace += "(" + std::to_string(size_t(node->getKind()));            \
+    }                                                                      \
+    void afterVisitNode([[maybe_unused]] ASTNode *node) { trace += ")"; }  \
+    void preVisitASTNode([[maybe_unused]] ASTNode *node) { trace += "<"; } \
+    void postVisitASTNode([[maybe_unused]] ASTNode *node) { trace += ">"; }
+
+struct RecursiveTracer : public ASTWalker<RecursiveTracer> {
+    TRACE_CALLBACKS
+};
+
+struct IterativeTracer : public IterativeASTWalker<IterativeTracer> {
+    TRACE_CALLBACKS
+};
+
+TEST(ASTWalker, IterativeMatchesRecursive)
+{
+    ASTContext ctx;
+    ASTNode *node = createExampleTree(ctx);
+
+    RecursiveTracer recursive;
+    recursive.visit(node);
+    IterativeTracer iterative;
+    iterative.visit(node);
+    EXPECT_EQ(iterative.trace, recursive.trace);
+}
+
+struct LiteralCounter : public IterativeASTWalker<LiteralCounter> {
+    size_t literals = 0;
+    void preVisitLiteralExpr([[maybe_unused]] LiteralExpr *node)
+    {
+        ++literals;
+    }
+};
+
+TEST(ASTWalker, IterativeWalksDeepTrees)
+{
+    ASTContext ctx;
+    auto &ast = ctx.getASTMemoryArena();
+    auto *intType = ctx.getIntType(glu::types::IntTy::Signed, 32);
+    auto createLiteral = [&] {
+        return ast.create<LiteralExpr>(
+            llvm::APInt(32, 1), intType, glu::SourceLocation(1)
+        );
+    };
+
+    // 1 + (1 + (1 + ...)), too deep for the native stack
+    constexpr size_t depth = 100'000;
+    ExprBase *expr = createLiteral();
+    for (size_t i = 0; i < depth; ++i) {
+        expr = ast.create<BinaryOpExpr>(
+            glu::SourceLocation(1), createLiteral(),
+            ast.create<RefExpr>(
+                glu::SourceLocation(1), NamespaceIdentifier { {}, "+" }
+            ),
+            expr
+        );
+    }
+
+    LiteralCounter counter;
+    counter.visit(expr);
+    EXPECT_EQ(counter.literals, depth + 1);
+}
@@ -0,0 +1,30 @@
+#include "AST/ASTContext.hpp"
+#include "AST/Decls.hpp"
+#include "AST/Types.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace glu::ast;
+using namespace glu::types;
+
+TEST(StructDeclTest, FieldIndexByName)
+{
+    ASTContext ctx;
+    auto &arena = ctx.getASTMemoryArena();
+    auto *intType = ctx.getIntType(IntTy::Signed, 32);
+    glu::SourceLocation loc(1);
+
+    llvm::SmallVector<FieldDecl *, 5> fields;
+    for (llvm::StringRef name : { "z", "a", "m", "a", "b" })
+        fields.push_back(arena.create<FieldDecl>(loc, name, intType));
+
+    auto *structDecl
+        = arena.create<StructDecl>(ctx, loc, nullptr, "S", fields);
+
+    EXPECT_EQ(structDecl->getFieldIndex("z"), 0u);
+    EXPECT_EQ(structDecl->getFieldIndex("a"), 1u);
+    EXPECT_EQ(structDecl->getFieldIndex("m"), 2u);
+    EXPECT_EQ(structDecl->getFieldIndex("b"), 4u);
+    EXPECT_EQ(structDecl->getFieldIndex("c"), std::nullopt);
+    EXPECT_EQ(structDecl->getType()->getFieldIndex("m"), 2u);
+}
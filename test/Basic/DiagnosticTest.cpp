@@ -195,3 +195,21 @@ TEST_F(DiagnosticTest, MultipleDiagnosticsOrder)
     ASSERT_LT(pos1, pos2);
     ASSERT_LT(pos2, pos3);
 }
+
+TEST_F(DiagnosticTest, TakeDiagnostics)
+{
+    glu::DiagnosticManager other { diagnostics.getSourceManager() };
+    diagnostics.warning(loc1, "A warning");
+    other.error(loc2, "An error");
+    other.note(loc3, "A note");
+
+    diagnostics.takeDiagnostics(other);
+
+    ASSERT_EQ(diagnostics.getMessages().size(), 2);
+    ASSERT_EQ(diagnostics.getMessages()[1].getMessage(), "An error");
+    ASSERT_NE(diagnostics.getMessages()[1].getNote(), nullptr);
+    ASSERT_TRUE(diagnostics.hasErrors());
+
+    ASSERT_TRUE(other.getMessages().empty());
+    ASSERT_FALSE(other.hasErrors());
+}
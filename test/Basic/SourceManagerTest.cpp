@@ -0,0 +1,81 @@
+#include "Basic/SourceManager.hpp"
+
+#include <gtest/gtest.h>
+
+class SourceManagerTest : public ::testing::Test {
+protected:
+    glu::SourceManager sm;
+
+    void SetUp() override
+    {
+        sm.loadBuffer(
+            llvm::MemoryBuffer::getMemBufferCopy("let a = 1;\n"
+                                                 "\n"
+                                                 "let bc = 2;\n"
+                                                 "a"),
+            "first.glu"
+        );
+        sm.loadBuffer(
+            llvm::MemoryBuffer::getMemBufferCopy("x\n"
+                                                 "  y\n"),
+            "second.glu"
+        );
+    }
+};
+
+TEST_F(SourceManagerTest, LineAndColumnNumbers)
+{
+    struct {
+        uint32_t offset;
+        unsigned line;
+        unsigned column;
+    } const expected[] = {
+        { 0, 1, 1 },  { 4, 1, 5 },  { 10, 1, 11 }, { 11, 2, 1 },
+        { 12, 3, 1 }, { 16, 3, 5 }, { 24, 4, 1 },
+        // second.glu starts at offset 25.
+        { 25, 1, 1 }, { 27, 2, 1 }, { 29, 2, 3 },
+    };
+    for (auto const &e : expected) {
+        glu::SourceLocation loc(e.offset);
+        EXPECT_EQ(sm.getSpellingLineNumber(loc), e.line) << e.offset;
+        EXPECT_EQ(sm.getSpellingColumnNumber(loc), e.column) << e.offset;
+    }
+}
+
+TEST_F(SourceManagerTest, Lines)
+{
+    EXPECT_EQ(sm.getLineStart(glu::SourceLocation(16)).getOffset(), 12u);
+    EXPECT_EQ(sm.getLineEnd(glu::SourceLocation(16)).getOffset(), 23u);
+    EXPECT_EQ(sm.getLine(glu::SourceLocation(16)), "let bc = 2;");
+    EXPECT_EQ(sm.getLine(glu::SourceLocation(11)), "");
+    EXPECT_EQ(sm.getLine(glu::SourceLocation(29)), "  y");
+}
+
+TEST_F(SourceManagerTest, FileIDLookups)
+{
+    sm.loadBuffer(llvm::MemoryBuffer::getMemBufferCopy(""), "empty.glu");
+    sm.loadBuffer(llvm::MemoryBuffer::getMemBufferCopy("z"), "third.glu");
+
+    EXPECT_EQ(sm.getBufferName(glu::SourceLocation(0)), "first.glu");
+    EXPECT_EQ(sm.getBufferName(glu::SourceLocation(24)), "first.glu");
+    EXPECT_EQ(sm.getBufferName(glu::SourceLocation(25)), "second.glu");
+    EXPECT_EQ(sm.getBufferName(glu::SourceLocation(30)), "second.glu");
+    EXPECT_EQ(sm.getBufferName(glu::SourceLocation(31)), "third.glu");
+    EXPECT_EQ(sm.getBufferName(glu::SourceLocation(3)), "first.glu");
+    EXPECT_EQ(sm.getBufferName(glu::SourceLocation(32)), "<unknown file>");
+    EXPECT_TRUE(sm.isInMainFile(glu::SourceLocation(5)));
+    EXPECT_FALSE(sm.isInMainFile(glu::SourceLocation(26)));
+}
+
+TEST_F(SourceManagerTest, LocationFromStringRef)
+{
+    for (uint32_t offset : { 0, 16, 24, 25, 29, 4 }) {
+        glu::SourceLocation loc(offset);
+        llvm::StringRef str(sm.getCharacterData(loc), 1);
+        EXPECT_EQ(sm.getSourceLocFromStringRef(str), loc) << offset;
+    }
+    EXPECT_EQ(
+        sm.getSourceLocFromStringRef("not in any buffer"),
+        glu::SourceLocation(0)
+    );
+}
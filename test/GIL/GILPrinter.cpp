@@ -145,7 +145,7 @@ TEST_F(GILPrinterTest, EnumVariantWithMemberOperand)
     fn->addBasicBlockAtEnd(bb);
 
     // Create enum variant instruction with Member operand
-    glu::gil::Member member("Green", enumTy, enumTy);
+    glu::gil::Member member("Green", enumTy, enumTy, 1);
     auto *enumInst = new EnumVariantInst(member);
     bb->getInstructions().push_back(enumInst);
 
@@ -137,7 +137,7 @@ TEST_F(IRGenTest, EnumReturn_GeneratesEnumConstantReturn)
     gilModule->addFunction(enumFunc);
     auto *entry = createEntry(enumFunc);
     // Create enum variant instruction
-    glu::gil::Member member("C", enumTy, enumTy);
+    glu::gil::Member member("C", enumTy, enumTy, 2);
     auto *enumInst = new glu::gil::EnumVariantInst(member);
     entry->getInstructions().push_back(enumInst);
     // Return the enum constant
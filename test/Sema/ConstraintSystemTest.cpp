@@ -731,3 +731,439 @@ TEST_F(ConstraintSystemTest, ModuleExpressionAutoMapping)
     EXPECT_EQ(expr1->getType(), intType); // T1 -> Int
     EXPECT_EQ(expr2->getType(), floatType); // T2 -> Float
 }
+
+// Test: Independent constraints are solved as separate components
+// Scenario: T1 = Int, T3 = Bool, T2 = T1 (T1 and T2 share a component)
+TEST_F(ConstraintSystemTest, PartitionIndependentComponents)
+{
+    auto &astArena = context->getASTMemoryArena();
+
+    auto *expr1 = astArena.create<ast::RefExpr>(
+        SourceLocation::invalid, ast::NamespaceIdentifier({}, "a")
+    );
+    auto *expr2 = astArena.create<ast::RefExpr>(
+        SourceLocation::invalid, ast::NamespaceIdentifier({}, "b")
+    );
+    auto *expr3 = astArena.create<ast::RefExpr>(
+        SourceLocation::invalid, ast::NamespaceIdentifier({}, "c")
+    );
+    expr1->setType(typeVar1);
+    expr2->setType(typeVar2);
+    expr3->setType(typeVar3);
+
+    auto *bindInt
+        = Constraint::createBind(cs->getAllocator(), typeVar1, intType, expr1);
+    auto *bindBool
+        = Constraint::createBind(cs->getAllocator(), typeVar3, boolType, expr3);
+    auto *bindVars
+        = Constraint::createBind(cs->getAllocator(), typeVar2, typeVar1, expr2);
+    cs->addConstraint(bindInt);
+    cs->addConstraint(bindBool);
+    cs->addConstraint(bindVars);
+
+    auto components = cs->partitionConstraints();
+    ASSERT_EQ(components.size(), 2u);
+    ASSERT_EQ(components[0].size(), 2u);
+    EXPECT_EQ(components[0][0], bindInt);
+    EXPECT_EQ(components[0][1], bindVars);
+    ASSERT_EQ(components[1].size(), 1u);
+    EXPECT_EQ(components[1][0], bindBool);
+
+    // Solving each component yields the combined solution
+    cs->setRoot(expr1);
+    ASSERT_TRUE(cs->solveConstraints());
+    EXPECT_EQ(expr1->getType(), intType);
+}
+
+// Test: Backtracking restores the state through the undo trail
+// Scenario: bind T1, checkpoint, rebind T1 and bind T2, then roll back
+TEST_F(ConstraintSystemTest, TrailRollbackRestoresState)
+{
+    SystemState state(context.get());
+
+    state.bindType(typeVar1, intType);
+    size_t checkpoint = state.checkpoint();
+
+    state.bindType(typeVar1, floatType);
+    state.bindType(typeVar2, boolType);
+    state.addSatisfiedDefaultable();
+    EXPECT_EQ(state.typeBindings.lookup(typeVar1), floatType);
+    EXPECT_EQ(state.defaultableConstraintsSatisfied, 1u);
+
+    state.rollback(checkpoint);
+    EXPECT_EQ(state.typeBindings.lookup(typeVar1), intType);
+    EXPECT_FALSE(state.typeBindings.count(typeVar2));
+    EXPECT_EQ(state.defaultableConstraintsSatisfied, 0u);
+
+    // Clones start a new history
+    EXPECT_TRUE(state.clone().trail.empty());
+}
+
+TEST_F(ConstraintSystemTest, ConversionLowerBoundTracksCertainConversions)
+{
+    SystemState state(context.get());
+    auto *concreteExpr = createIntLiteral(1);
+    auto *pendingExpr = createIntLiteral(2, typeVar1);
+
+    // The target still contains a type variable: not counted yet
+    size_t checkpoint = state.checkpoint();
+    state.setImplicitConversion(pendingExpr, floatType);
+    EXPECT_EQ(state.getConversionLowerBound(), 0u);
+
+    state.setImplicitConversion(concreteExpr, floatType);
+    EXPECT_EQ(state.getConversionLowerBound(), 1u);
+    EXPECT_EQ(
+        state.getConversionLowerBound(), state.getImplicitConversionCount() - 1
+    );
+
+    state.rollback(checkpoint);
+    EXPECT_EQ(state.getConversionLowerBound(), 0u);
+    EXPECT_TRUE(state.implicitConversions.empty());
+
+    // Best solutions keep their score so that worse states can be pruned
+    SolutionResult result;
+    state.setImplicitConversion(concreteExpr, floatType);
+    result.tryAddSolution(state);
+    EXPECT_EQ(result.bestScore, 1u);
+    EXPECT_TRUE(result.canImprove(state));
+    state.setImplicitConversion(createIntLiteral(3), boolType);
+    EXPECT_FALSE(result.canImprove(state));
+}
+
+TEST_F(ConstraintSystemTest, FilterImpossibleOverloads)
+{
+    auto &astArena = context->getASTMemoryArena();
+    auto &typeArena = context->getTypesMemoryArena();
+    auto *charType = typeArena.create<CharTy>();
+
+    auto *ref = astArena.create<ast::RefExpr>(
+        SourceLocation::invalid, ast::NamespaceIdentifier({}, "f")
+    );
+    ref->setType(typeVar1);
+    auto *callExpr = astArena.create<ast::CallExpr>(
+        SourceLocation::invalid, ref,
+        llvm::SmallVector<ast::ExprBase *> { createIntLiteral(42, typeVar2) }
+    );
+    callExpr->setType(typeVar3);
+
+    llvm::SmallVector<Constraint *, 4> branches;
+    llvm::SmallVector<ast::FunctionDecl *, 4> overloads;
+    for (llvm::SmallVector<TypeBase *, 2> params :
+         { llvm::SmallVector<TypeBase *, 2> { charType },
+           llvm::SmallVector<TypeBase *, 2> { boolType },
+           llvm::SmallVector<TypeBase *, 2> { intType },
+           llvm::SmallVector<TypeBase *, 2> { intType, intType } }) {
+        auto *overload = ast::FunctionDecl::create(
+            allocator, SourceLocation::invalid, nullptr, "f",
+            typeArena.create<FunctionTy>(params, intType), {}, nullptr
+        );
+        overloads.push_back(overload);
+        branches.push_back(
+            Constraint::createBindOverload(
+                cs->getAllocator(), typeVar1, overload, ref
+            )
+        );
+    }
+    cs->addConstraint(
+        Constraint::createDisjunction(
+            cs->getAllocator(), branches, ref, /*rememberChoice=*/false
+        )
+    );
+
+    cs->simplifyConstraints();
+
+    // f(Bool) and f(Int, Int) cannot take an integer literal, and the exact
+    // match f(Int) is tried before f(Char)
+    ASSERT_EQ(cs->getConstraints().size(), 1u);
+    auto nested = cs->getConstraints()[0]->getNestedConstraints();
+    ASSERT_EQ(nested.size(), 2u);
+    EXPECT_EQ(nested[0]->getOverloadChoice(), overloads[2]);
+    EXPECT_EQ(nested[1]->getOverloadChoice(), overloads[0]);
+}
+
+TEST_F(ConstraintSystemTest, MemoizedSubstitutionFollowsBindings)
+{
+    auto &typeArena = context->getTypesMemoryArena();
+    SystemState state(context.get());
+    auto *pointerToVar = typeArena.create<PointerTy>(typeVar1);
+
+    EXPECT_EQ(state.substitute(intType), intType);
+    EXPECT_EQ(state.substitute(pointerToVar), pointerToVar);
+
+    size_t checkpoint = state.checkpoint();
+    state.bindType(typeVar1, intType);
+    EXPECT_EQ(
+        state.substitute(pointerToVar), typeArena.create<PointerTy>(intType)
+    );
+
+    state.rollback(checkpoint);
+    EXPECT_EQ(state.substitute(pointerToVar), pointerToVar);
+}
+
+TEST_F(ConstraintSystemTest, StateBudgetStopsExploration)
+{
+    auto *literal = createIntLiteral(1, typeVar1);
+    llvm::SmallVector<TypeBase *, 3> types { intType, floatType, boolType };
+    llvm::SmallVector<Constraint *, 3> branches;
+    for (auto *type : types) {
+        branches.push_back(
+            Constraint::createBind(cs->getAllocator(), typeVar1, type, literal)
+        );
+    }
+    cs->addConstraint(
+        Constraint::createDisjunction(
+            cs->getAllocator(), branches, literal, /*rememberChoice=*/false
+        )
+    );
+
+    SolverStatistics stats;
+    cs->setStatistics(&stats);
+    cs->setStateBudget(2);
+    cs->setRoot(literal);
+    EXPECT_FALSE(cs->solveConstraints());
+    EXPECT_TRUE(cs->hasExceededBudget());
+    EXPECT_TRUE(diagManager->hasErrors());
+
+    ASSERT_EQ(stats.getRecords().size(), 1u);
+    EXPECT_EQ(stats.getRecords()[0].constraints, 1u);
+    EXPECT_EQ(stats.getRecords()[0].components, 1u);
+    EXPECT_EQ(stats.getRecords()[0].peakWorklist, 1u);
+}
+
+TEST_F(ConstraintSystemTest, ScratchTypesKeepTypeVariablesOutOfContext)
+{
+    auto &typeArena = context->getTypesMemoryArena();
+    PointerTy *scratchPointer;
+    PointerTy *concretePointer;
+    {
+        auto scratchTypes = cs->useScratchTypes();
+        auto *typeVar = typeArena.create<TypeVariableTy>();
+        scratchPointer = typeArena.create<PointerTy>(typeVar1);
+        concretePointer = typeArena.create<PointerTy>(intType);
+
+        EXPECT_NE(typeVar, typeVar1);
+        EXPECT_EQ(typeArena.create<PointerTy>(typeVar1), scratchPointer);
+    }
+
+    // Types without type variables are interned in the context as usual,
+    // temporary ones are not visible outside the system.
+    EXPECT_EQ(typeArena.create<PointerTy>(intType), concretePointer);
+    EXPECT_NE(typeArena.create<PointerTy>(typeVar1), scratchPointer);
+}
+
+TEST_F(ConstraintSystemTest, ScratchTypesRetainedOnlyAfterOwnErrors)
+{
+    auto createSystem = [this] {
+        return std::make_unique<ConstraintSystem>(
+            scopeTable.get(), *diagManager, context.get()
+        );
+    };
+
+    // An earlier statement failed: systems that then solve without errors
+    // still free their scratch types.
+    cs.reset();
+    diagManager->error(SourceLocation::invalid, "earlier error");
+    cs = createSystem();
+    cs.reset();
+    EXPECT_EQ(context->getRetainedTypesArenaCount(), 0u);
+
+    // A system reporting errors keeps them, as the AST may reference them.
+    cs = createSystem();
+    diagManager->error(SourceLocation::invalid, "unsolvable statement");
+    cs.reset();
+    EXPECT_EQ(context->getRetainedTypesArenaCount(), 1u);
+}
+
+TEST_F(ConstraintSystemTest, OperatorOverloadIndexByFirstOperand)
+{
+    auto &typeArena = context->getTypesMemoryArena();
+    auto *charType = typeArena.create<CharTy>();
+    auto *pointerType = typeArena.create<PointerTy>(intType);
+
+    ScopeItem item;
+    llvm::SmallVector<ast::FunctionDecl *, 4> overloads;
+    for (TypeBase *param :
+         std::initializer_list<TypeBase *> { intType, floatType, pointerType,
+                                             typeVar1 }) {
+        auto *overload = ast::FunctionDecl::create(
+            allocator, SourceLocation::invalid, nullptr, "==",
+            typeArena.create<FunctionTy>(
+                llvm::SmallVector<TypeBase *, 2> { param, param }, boolType
+            ),
+            {}, nullptr
+        );
+        overloads.push_back(overload);
+        item.decls.push_back({ ast::Visibility::Public, overload });
+    }
+
+    auto &index = scopeTable->getOperatorTable().getOverloads(item);
+    EXPECT_EQ(&scopeTable->getOperatorTable().getOverloads(item), &index);
+
+    // Characters implicitly convert to integers, and anything can bind to
+    // the generic overload
+    llvm::SmallPtrSet<ast::FunctionDecl *, 4> candidates;
+    index.getCandidates(charType, candidates);
+    EXPECT_EQ(candidates.size(), 2u);
+    EXPECT_TRUE(candidates.contains(overloads[0]));
+    EXPECT_TRUE(candidates.contains(overloads[3]));
+
+    candidates.clear();
+    index.getCandidates(floatType, candidates);
+    EXPECT_EQ(candidates.size(), 2u);
+    EXPECT_TRUE(candidates.contains(overloads[1]));
+
+    candidates.clear();
+    index.getCandidates(boolType, candidates);
+    EXPECT_EQ(candidates.size(), 1u);
+    EXPECT_TRUE(candidates.contains(overloads[3]));
+}
+
+TEST_F(ConstraintSystemTest, OverloadCacheComputesEachCallShapeOnce)
+{
+    auto &cache = scopeTable->getOverloadCache();
+    auto *overload = ast::FunctionDecl::create(
+        allocator, SourceLocation::invalid, nullptr, "+",
+        context->getTypesMemoryArena().create<FunctionTy>(
+            llvm::SmallVector<TypeBase *, 2> { intType, intType }, intType
+        ),
+        {}, nullptr
+    );
+    ScopeItem item;
+    item.decls.push_back({ ast::Visibility::Public, overload });
+
+    int computed = 0;
+    auto compute = [&] {
+        ++computed;
+        return OverloadCache::Candidates { overload };
+    };
+    OverloadCache::Key intArgs { &item, 1, { intType, intType }, nullptr };
+    OverloadCache::Key floatArgs { &item, 1, { floatType, intType }, nullptr };
+
+    EXPECT_EQ(cache.getCandidates(intArgs, compute).size(), 1u);
+    EXPECT_EQ(
+        &cache.getCandidates(intArgs, compute),
+        &cache.getCandidates(intArgs, compute)
+    );
+    EXPECT_EQ(computed, 1);
+    cache.getCandidates(floatArgs, compute);
+    EXPECT_EQ(computed, 2);
+}
+
+/// @brief Solves operator applications against the `==` overloads of a
+/// module: (Int, Int), (Bool, Bool) and (*Int, *Int).
+class OverloadSolvingTest : public ConstraintSystemTest {
+protected:
+    llvm::SmallVector<ast::FunctionDecl *, 3> overloads;
+    std::unique_ptr<ScopeTable> operators;
+
+    void SetUp() override
+    {
+        ConstraintSystemTest::SetUp();
+        auto &typeArena = context->getTypesMemoryArena();
+        llvm::SmallVector<ast::DeclBase *, 3> decls;
+        for (TypeBase *param : std::initializer_list<TypeBase *> {
+                 intType, boolType, typeArena.create<PointerTy>(intType) }) {
+            auto *overload = ast::FunctionDecl::create(
+                allocator, SourceLocation::invalid, nullptr, "==",
+                typeArena.create<FunctionTy>(
+                    llvm::SmallVector<TypeBase *, 2> { param, param }, boolType
+                ),
+                {}, nullptr
+            );
+            overloads.push_back(overload);
+            decls.push_back(overload);
+        }
+        operators = std::make_unique<ScopeTable>(ast::ModuleDecl::create(
+            allocator, SourceLocation(0), decls, context.get()
+        ));
+    }
+
+    /// @brief Solves `x == y` with both operands bound to Int, the way
+    /// LocalCSWalker would, and returns the number of states explored.
+    size_t solveIntEquality()
+    {
+        auto &astArena = context->getASTMemoryArena();
+        auto &typeArena = context->getTypesMemoryArena();
+        ConstraintSystem system(operators.get(), *diagManager, context.get());
+
+        auto *lhs = astArena.create<ast::RefExpr>(
+            SourceLocation::invalid, ast::NamespaceIdentifier({}, "x")
+        );
+        auto *rhs = astArena.create<ast::RefExpr>(
+            SourceLocation::invalid, ast::NamespaceIdentifier({}, "y")
+        );
+        auto *op = astArena.create<ast::RefExpr>(
+            SourceLocation::invalid, ast::NamespaceIdentifier({}, "==")
+        );
+        auto *equality = astArena.create<ast::BinaryOpExpr>(
+            SourceLocation::invalid, lhs, op, rhs
+        );
+        lhs->setType(typeArena.create<TypeVariableTy>());
+        rhs->setType(typeArena.create<TypeVariableTy>());
+        op->setType(typeArena.create<TypeVariableTy>());
+        equality->setType(typeArena.create<TypeVariableTy>());
+
+        auto &alloc = system.getAllocator();
+        system.addConstraint(
+            Constraint::createBind(alloc, lhs->getType(), intType, lhs)
+        );
+        system.addConstraint(
+            Constraint::createBind(alloc, rhs->getType(), intType, rhs)
+        );
+        llvm::SmallVector<Constraint *, 3> branches;
+        for (auto *overload : overloads) {
+            branches.push_back(
+                Constraint::createBindOverload(
+                    alloc, op->getType(), overload, op
+                )
+            );
+        }
+        system.addConstraint(
+            Constraint::createDisjunction(
+                alloc, branches, op, /*rememberChoice=*/false
+            )
+        );
+        system.addConstraint(
+            Constraint::createConversion(
+                alloc, op,
+                typeArena.create<FunctionTy>(
+                    llvm::SmallVector<TypeBase *, 2> { lhs->getType(),
+                                                       rhs->getType() },
+                    equality->getType()
+                )
+            )
+        );
+
+        SolverStatistics stats;
+        system.setStatistics(&stats);
+        system.setRoot(equality);
+        EXPECT_TRUE(system.solveConstraints());
+        EXPECT_EQ(op->getType(), overloads[0]->getType());
+        EXPECT_EQ(equality->getType(), boolType);
+        return stats.getRecords().empty()
+            ? 0
+            : stats.getRecords()[0].exploredStates;
+    }
+};
+
+TEST_F(OverloadSolvingTest, NonMatchingOverloadsAreNeverTried)
+{
+    // The operands are still type variables when the overloads are
+    // filtered before solving, but they are bound to Int by the time the
+    // disjunction is reached: only ==(Int, Int) is explored.
+    EXPECT_EQ(solveIntEquality(), 1u);
+    EXPECT_FALSE(diagManager->hasErrors());
+}
+
+TEST_F(OverloadSolvingTest, RepeatedCallShapesHitTheOverloadCache)
+{
+    auto &cache = operators->getOverloadCache();
+    ASSERT_EQ(cache.size(), 0u);
+
+    // Each statement gets its own system, but `==` on two Int is resolved
+    // once for the module and prunes the other overloads in both.
+    EXPECT_EQ(solveIntEquality(), 1u);
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(solveIntEquality(), 1u);
+    EXPECT_EQ(cache.size(), 1u);
+}
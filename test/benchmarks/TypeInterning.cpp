@@ -0,0 +1,134 @@
+// Compares the throughput of the sharded types arena with a single-lock
+// interning arena, the layout the types arena had before sharding, and the
+// cost of the scratch arena every constraint system creates and destroys.
+//
+// Usage: type_interning_bench [threads] [rounds]
+
+#include "AST/ASTContext.hpp"
+#include "AST/Types.hpp"
+
+#include <llvm/Support/Format.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace glu;
+using namespace glu::types;
+
+namespace {
+
+/// @brief A single set behind a single lock.
+class SingleLockArena : public TypedMemoryArena<TypeBase> {
+    llvm::DenseSet<TypeBase *, BaseDenseSetInternInfo<TypeBase>> _internedSet;
+    std::mutex _mutex;
+    llvm::BumpPtrAllocator _keyAllocator;
+
+public:
+    template <typename T, typename... Args> T *create(Args &&...args)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        T *key = this->template createWithAllocator<T>(_keyAllocator, args...);
+        auto it = _internedSet.find_as(key);
+        _keyAllocator.Reset();
+        if (it != _internedSet.end())
+            return llvm::cast<T>(*it);
+
+        T *obj = this->template createWithAllocator<T>(
+            this->getAllocator(), std::forward<Args>(args)...
+        );
+        _internedSet.insert(obj);
+        return obj;
+    }
+};
+
+/// @brief Creates the same mix of types from every thread: mostly lookups of
+/// existing types, as during type checking, and a few new ones.
+template <typename Arena>
+double run(Arena &arena, unsigned threadCount, unsigned rounds)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&arena, rounds, t] {
+            for (unsigned round = 0; round < rounds; ++round) {
+                for (unsigned width = 1; width <= 64; ++width) {
+                    auto *intType
+                        = arena.template create<IntTy>(IntTy::Signed, width);
+                    auto *ptrType = arena.template create<PointerTy>(intType);
+                    arena.template create<FunctionTy>(
+                        llvm::ArrayRef<TypeBase *> { intType, ptrType },
+                        intType
+                    );
+                }
+                arena.template create<StaticArrayTy>(
+                    arena.template create<BoolTy>(), t * rounds + round
+                );
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+    std::chrono::duration<double> elapsed
+        = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+/// @brief Creates and destroys a scratch arena of 2^shardBits shards per
+/// round, interning a few types in it, as a small constraint system does.
+double runScratch(unsigned shardBits, unsigned rounds)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned round = 0; round < rounds; ++round) {
+        InternedMemoryArena<TypeBase> scratch(shardBits);
+        for (unsigned width = 1; width <= 4; ++width)
+            scratch.create<PointerTy>(
+                scratch.create<IntTy>(IntTy::Signed, width)
+            );
+    }
+    std::chrono::duration<double> elapsed
+        = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    unsigned threadCount = argc > 1 ? std::atoi(argv[1])
+                                    : std::thread::hardware_concurrency();
+    unsigned rounds = argc > 2 ? std::atoi(argv[2]) : 2000;
+    double creations = double(threadCount) * rounds * (64 * 3 + 2);
+
+    SingleLockArena singleLock;
+    double singleLockTime = run(singleLock, threadCount, rounds);
+
+    ast::ASTContext context;
+    double shardedTime
+        = run(context.getTypesMemoryArena(), threadCount, rounds);
+
+    llvm::outs() << threadCount << " threads, " << rounds << " rounds\n";
+    llvm::outs() << llvm::format(
+        "single lock: %8.3fs %10.0f types/s\n", singleLockTime,
+        creations / singleLockTime
+    );
+    llvm::outs() << llvm::format(
+        "sharded:     %8.3fs %10.0f types/s\n", shardedTime,
+        creations / shardedTime
+    );
+
+    unsigned scratchRounds = rounds * 50;
+    double shardedScratchTime = runScratch(4, scratchRounds);
+    double singleScratchTime = runScratch(0, scratchRounds);
+    llvm::outs() << llvm::format(
+        "scratch, 16 shards: %8.3fs %10.0f arenas/s\n", shardedScratchTime,
+        scratchRounds / shardedScratchTime
+    );
+    llvm::outs() << llvm::format(
+        "scratch, 1 shard:   %8.3fs %10.0f arenas/s\n", singleScratchTime,
+        scratchRounds / singleScratchTime
+    );
+    return 0;
+}
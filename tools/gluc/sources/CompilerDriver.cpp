@@ -1,5 +1,6 @@
 #include "CompilerDriver.hpp"
 
+#include "AST/ASTStatistics.hpp"
 #include "ClangImporter/ClangImporter.hpp"
 #include "GILGen/GILGen.hpp"
 #include "IRDec/ModuleLifter.hpp"
@@ -43,15 +44,17 @@ std::vector<std::string> CompilerDriver::findImportedObjectFiles()
 {
     std::vector<std::string> importedFiles;
 
-    // First, process any skipped private imports to ensure they are handled
-    // before we look for their object files.
-    _importManager->processSkippedImports();
-
-    auto const &importedFilesMap = _importManager->getImportedFiles();
+    // Only the modules providing symbols referenced by the generated code are
+    // linked (with their own dependencies). Skipped private imports are
+    // loaded only for those modules.
+    auto linkedFiles = _importManager->collectLinkedFiles(
+        llvm::SmallVector<glu::ast::ModuleDecl *, 8>(
+            _referencedModules.begin(), _referencedModules.end()
+        )
+    );
     auto *sourceManager = _importManager->getASTContext().getSourceManager();
 
-    for (auto const &entry : importedFilesMap) {
-        glu::FileID fileID = entry.first;
+    for (glu::FileID fileID : linkedFiles) {
         llvm::StringRef filePath = sourceManager->getBufferName(fileID);
         if (filePath.ends_with(".glu")) {
             std::string objPath = filePath.str();
@@ -174,6 +177,35 @@ bool CompilerDriver::parseCommandLine(int argc, char **argv)
         "sanitize-address", desc("Enable AddressSanitizer"), init(false)
     );
 
+    opt<bool> PrintSolverStats(
+        "print-solver-stats",
+        desc("Print constraint solver statistics after semantic analysis"),
+        init(false)
+    );
+
+    opt<bool> PrintASTStats(
+        "print-ast-stats",
+        desc("Print the number and size of AST nodes and types by kind after "
+             "semantic analysis"),
+        init(false)
+    );
+
+    opt<unsigned> SolverStateBudget(
+        "solver-state-budget",
+        desc("Maximum number of states the constraint solver may explore for "
+             "a single statement (0 for no limit)"),
+        init(glu::sema::SolverOptions::defaultStateBudget),
+        value_desc("states")
+    );
+
+    opt<unsigned> SemaThreads(
+        "sema-threads",
+        desc("Number of threads checking function bodies, constraint "
+             "components and imported modules concurrently (0 for one per "
+             "hardware thread)"),
+        init(1), value_desc("threads")
+    );
+
     opt<std::string> InputFilename(
         Positional, Required, desc("<input glu file>")
     );
@@ -190,6 +222,10 @@ bool CompilerDriver::parseCommandLine(int argc, char **argv)
                 .linkerArgs = {},
                 .optLevel = OptimizationLevel,
                 .asan = AddressSanitizer,
+                .printSolverStats = PrintSolverStats,
+                .printASTStats = PrintASTStats,
+                .solverStateBudget = SolverStateBudget,
+                .semaThreads = SemaThreads,
                 .stage = CompilerStage };
 
     _config.importDirs.assign(ImportDirs.begin(), ImportDirs.end());
@@ -335,13 +371,39 @@ int CompilerDriver::runParser()
     return 0;
 }
 
+llvm::ThreadPoolInterface *CompilerDriver::getThreadPool()
+{
+    if (_config.semaThreads == 1) {
+        return nullptr;
+    }
+    if (!_threadPool) {
+        _threadPool.emplace(llvm::hardware_concurrency(_config.semaThreads));
+    }
+    return &*_threadPool;
+}
+
 int CompilerDriver::runSema()
 {
+    sema::SolverOptions solverOptions;
+    solverOptions.dumpConstraints = _config.stage == PrintConstraints;
+    solverOptions.stats = _config.printSolverStats ? &_solverStats : nullptr;
+    solverOptions.stateBudget = _config.solverStateBudget;
+    solverOptions.threadPool = getThreadPool();
     _moduleScope = sema::constrainAST(
-        _ast, _diagManager, &(*_importManager),
-        _config.stage == PrintConstraints
+        _ast, _diagManager, &(*_importManager), solverOptions
     );
 
+    if (_config.printSolverStats) {
+        _solverStats.print(llvm::errs(), _sourceManager);
+    }
+
+    if (_config.printASTStats) {
+        glu::ast::ASTStatistics astStats;
+        astStats.addModule(_ast);
+        astStats.addContext(_context);
+        astStats.print(llvm::errs());
+    }
+
     if (_config.stage == PrintConstraints) {
         // Constraints are printed by the constrainAST function itself
         return 0;
@@ -414,7 +476,9 @@ int CompilerDriver::runIRGen()
         _llvmContext
     );
     setupTriple();
-    irgen.generateIR(*_llvmModule, _gilModule.get(), &_sourceManager);
+    irgen.generateIR(
+        *_llvmModule, _gilModule.get(), &_sourceManager, &_referencedModules
+    );
 
     // Apply optimizations if requested
     applyOptimizations();
@@ -637,6 +701,7 @@ int CompilerDriver::performCompilation()
     _importManager.emplace(
         _context, _diagManager, _config.importDirs, _config.targetTriple
     );
+    _importManager->setThreadPool(getThreadPool());
 
     // Configure parser
     if (!loadSourceFile()) {
@@ -15,10 +15,13 @@
 #include "Parser/Parser.hpp"
 #include "Scanner.hpp"
 #include "Sema/ImportManager.hpp"
+#include "Sema/SolverStatistics.hpp"
 
+#include <llvm/ADT/SmallPtrSet.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 #include <llvm/Support/Allocator.h>
+#include <llvm/Support/ThreadPool.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Target/TargetMachine.h>
 
@@ -70,6 +73,12 @@ class CompilerDriver {
         std::vector<std::string> linkerArgs; ///< Arguments to pass to linker
         unsigned optLevel = 0; ///< Optimization level (0-3)
         bool asan = false; ///< Whether to enable AddressSanitizer
+        bool printSolverStats = false; ///< Whether to print solver statistics
+        bool printASTStats = false; ///< Whether to print AST node statistics
+        unsigned solverStateBudget
+            = 0; ///< Maximum solver states per statement (0 for no limit)
+        unsigned semaThreads
+            = 1; ///< Threads of semantic analysis (0 for all cores)
         Stage stage;
     };
 
@@ -81,6 +90,8 @@ class CompilerDriver {
     glu::SourceManager _sourceManager; ///< Manages source files and locations
     glu::DiagnosticManager _diagManager; ///< Handles error/warning reporting
     glu::ast::ASTContext _context; ///< AST memory management and context
+    std::optional<llvm::DefaultThreadPool>
+        _threadPool; ///< Runs the concurrent work of semantic analysis
     std::optional<glu::sema::ImportManager>
         _importManager; ///< Handles module imports
 
@@ -104,6 +115,10 @@ class CompilerDriver {
         = nullptr; ///< Scope table for the main module
     std::unique_ptr<glu::gil::Module>
         _gilModule; ///< Generated GIL intermediate representation
+    llvm::SmallPtrSet<glu::ast::ModuleDecl *, 8>
+        _referencedModules; ///< Modules declaring symbols used by IRGen
+    glu::sema::SolverStatistics
+        _solverStats; ///< Constraint solver statistics, if requested
 
 public:
     /// @brief Constructs a new CompilerDriver with default settings
@@ -155,6 +170,11 @@ private:
     /// @return Exit code (0 for success, non-zero for error)
     int runParser();
 
+    /// @brief Get the pool shared by the concurrent work of semantic
+    /// analysis, created on first use
+    /// @return The pool, or nullptr with -sema-threads=1
+    llvm::ThreadPoolInterface *getThreadPool();
+
     /// @brief Run semantic analysis on the AST
     /// @return Exit code (0 for success, non-zero for error)
     int runSema();